@@ -0,0 +1,95 @@
+/*
+ * Test the 16 bit CRC against the reference model.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of either:
+ *
+ *  a) the GNU General Public License as published by the Free Software
+ *     Foundation; either version 2 of the License, or (at your option)
+ *     any later version, or
+ *  b) the Apache License, Version 2.0
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include "crcmodel.h"
+#include "crc16_constants.h"
+
+#define MAX_CRC_LENGTH	70000
+#define ITERATIONS	2000
+
+unsigned short crc16_vpmsum(unsigned short crc, const unsigned char *p,
+			    unsigned long len);
+
+static unsigned short verify_crc(unsigned short crc, const unsigned char *p,
+				 unsigned long len)
+{
+	cm_t cm_t = { 0, };
+	int i;
+
+	cm_t.cm_width = CRC_WIDTH;
+	cm_t.cm_poly  = CRC >> (32 - CRC_WIDTH);
+	cm_t.cm_init  = crc;
+#ifdef REFLECT
+	cm_t.cm_refin = TRUE;
+	cm_t.cm_refot = TRUE;
+#else
+	cm_t.cm_refin = FALSE;
+	cm_t.cm_refot = FALSE;
+#endif
+	cm_t.cm_xorot = 0x0;
+	cm_ini(&cm_t);
+
+	for (i = 0; i < len; i++)
+		cm_nxt(&cm_t, p[i]);
+
+	return cm_crc(&cm_t);
+}
+
+int main(void)
+{
+	unsigned char *data;
+	unsigned long i, size;
+	int ret = 0;
+
+	size = MAX_CRC_LENGTH + 16;
+	data = malloc(size);
+	if (!data) {
+		perror("malloc");
+		exit(1);
+	}
+
+	srandom(1);
+
+	for (i = 0; i < size; i++)
+		data[i] = random() & 0xff;
+
+	for (i = 0; i < ITERATIONS; i++) {
+		const unsigned char *p = data + random() % 16;
+		unsigned short init, crc, verify;
+		unsigned long len;
+
+		/* Favour the short lengths, where the edge cases are */
+		len = random() % (i % 16 ? 1000 : MAX_CRC_LENGTH);
+
+		/* Sector sizes */
+		if (i % 16 == 1)
+			len = 512;
+		else if (i % 16 == 2)
+			len = 4096;
+
+		init = random() & ((1 << CRC_WIDTH) - 1);
+
+		crc = crc16_vpmsum(init, p, len);
+		verify = verify_crc(init, p, len);
+
+		if (crc != verify) {
+			printf("FAILURE: got 0x%04x expected 0x%04x (len %lu)\n",
+			       crc, verify, len);
+			ret = 1;
+		}
+	}
+
+	free(data);
+
+	return ret;
+}
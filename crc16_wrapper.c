@@ -0,0 +1,52 @@
+/*
+ * Calculate a CRC of 16 bits or less, eg CRC-16/T10-DIF, with the 32 bit
+ * vpmsum code.
+ *
+ * A CRC of width w with polynomial p(x) is the top w bits of the 32 bit
+ * CRC with polynomial p(x) * x^(32-w), given an initial value shifted up
+ * by the same amount. crc32_constants -w generates the constants for the
+ * wider polynomial, so the folding and Barrett reduction are exactly the
+ * 32 bit ones and run at the same speed. A reflected CRC sits in the
+ * bottom w bits of the 32 bit one and needs no shift at all.
+ *
+ * The Makefile builds vec_crc32.c with these constants as __crc16_vpmsum.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of either:
+ *
+ *  a) the GNU General Public License as published by the Free Software
+ *     Foundation; either version 2 of the License, or (at your option)
+ *     any later version, or
+ *  b) the Apache License, Version 2.0
+ */
+#ifdef CRC32_CONSTANTS_HEADER
+#include CRC32_CONSTANTS_HEADER
+#else
+#include "crc16_constants.h"
+#endif
+
+#if !defined(CRC_WIDTH) || CRC_WIDTH > 16
+#error "Generate the constants with crc32_constants -w 16 or less"
+#endif
+
+#ifndef CRC16_FUNCTION
+#define CRC16_FUNCTION		crc16_vpmsum
+#endif
+#ifndef CRC32_FUNCTION
+#define CRC32_FUNCTION		__crc16_vpmsum
+#endif
+
+unsigned int CRC32_FUNCTION(unsigned int crc, const unsigned char *p,
+			    unsigned long len);
+
+/* crc must fit in CRC_WIDTH bits */
+unsigned short CRC16_FUNCTION(unsigned short crc, const unsigned char *p,
+			      unsigned long len)
+{
+#ifdef REFLECT
+	return CRC32_FUNCTION(crc, p, len);
+#else
+	return CRC32_FUNCTION((unsigned int)crc << (32 - CRC_WIDTH), p, len) >>
+		(32 - CRC_WIDTH);
+#endif
+}
@@ -0,0 +1,84 @@
+/*
+ * Benchmark crc32_vpmsum on buffers that aren't in cache. crc32_bench
+ * checksums the same buffer over and over, so everything after the first
+ * pass comes from L1. Here we carve a pool much larger than the caches
+ * into buffers of [length] bytes and walk through them in turn, so each
+ * buffer has been evicted by the time we get back to it.
+ *
+ * Shrink the pool to measure a given level instead: eg a pool of a few
+ * MB stays in L3.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of either:
+ *
+ *  a) the GNU General Public License as published by the Free Software
+ *     Foundation; either version 2 of the License, or (at your option)
+ *     any later version, or
+ *  b) the Apache License, Version 2.0
+ */
+#include <malloc.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+
+unsigned int crc32_vpmsum(unsigned int crc, unsigned char *p, unsigned long len);
+
+#define DEFAULT_POOL_MB	512
+
+int main(int argc, char *argv[])
+{
+	unsigned long length, iterations, pool, stride, nbufs;
+	struct timespec start, end;
+	unsigned char *data;
+	unsigned long i;
+	unsigned int crc = 0;
+	double secs;
+
+	if (argc != 3 && argc != 4) {
+		fprintf(stderr, "Usage: %s length iterations [pool MB]\n", argv[0]);
+		fprintf(stderr, "Performs crc32 checksum an [iterations] number of times on buffers of [length] bytes taken in turn from a [pool MB] (default %d) pool, so they are not in cache\n",
+			DEFAULT_POOL_MB);
+		exit(1);
+	}
+
+	length = strtoul(argv[1], NULL, 0);
+	iterations = strtoul(argv[2], NULL, 0);
+	pool = DEFAULT_POOL_MB;
+	if (argc == 4)
+		pool = strtoul(argv[3], NULL, 0);
+	pool <<= 20;
+
+	/* Keep each buffer page aligned, like crc32_bench. */
+	stride = (length + getpagesize() - 1) & ~(getpagesize() - 1UL);
+	if (!stride)
+		stride = getpagesize();
+	nbufs = pool / stride;
+	if (!nbufs)
+		nbufs = 1;
+
+	data = memalign(getpagesize(), nbufs * stride);
+	if (!data) {
+		perror("memalign");
+		exit(1);
+	}
+
+	srandom(1);
+	for (i = 0; i < nbufs * stride; i++)
+		data[i] = random() & 0xff;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+
+	for (i = 0; i < iterations; i++)
+		crc = crc32_vpmsum(crc, data + (i % nbufs) * stride, length);
+
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	secs = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+
+	printf("CRC: %08x\n", crc);
+	printf("%lu buffers, %.1f MB/s\n", nbufs,
+	       secs ? length * (double)iterations / secs / 1e6 : 0.0);
+
+	return 0;
+}
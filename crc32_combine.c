@@ -0,0 +1,142 @@
+/*
+ * Combine the CRCs of two buffers A and B into the CRC of A followed by B,
+ * without touching the data again.
+ *
+ * A CRC is a linear function, so appending len2 bytes to A multiplies the
+ * CRC of A by x^(8*len2) mod p(x). The CRC of B is then simply xored in:
+ *
+ *	CRC(A . B) = (CRC(A) . (x^(8*len2) mod p(x))) xor CRC(B)
+ *
+ * This holds whether or not the input and output are inverted, as long as
+ * both are done the same way (which CRC_XOR does).
+ *
+ * The multiply is a single vpmsumd followed by a Barrett reduction. The
+ * shift constant x^(8*len2) mod p(x) is built from the generated table of
+ * x^(8*2^k) mod p(x), one multiply per set bit of len2, so the cost is
+ * O(log n). If the same length is used many times, it can be generated
+ * once with crc32_combine_gen() and applied with crc32_combine_op().
+ *
+ * The same shift gives the CRC of a run of zeros in O(log n) without
+ * reading them, crc32_vpmsum_zeros(). Unlike a combine, the run starts
+ * from the caller's CRC, so the CRC_XOR inversion has to be undone
+ * before the shift and reapplied after it.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of either:
+ *
+ *  a) the GNU General Public License as published by the Free Software
+ *     Foundation; either version 2 of the License, or (at your option)
+ *     any later version, or
+ *  b) the Apache License, Version 2.0
+ */
+
+#include <altivec.h>
+
+#define POWER8_BARRETT_INTRINSICS
+#define CRC_SHIFT_TABLE
+
+#ifdef CRC32_CONSTANTS_HEADER
+#include CRC32_CONSTANTS_HEADER
+#else
+#include "crc32_constants.h"
+#endif
+
+#if defined (__clang__)
+#include "clang_workaround.h"
+#else
+#define __builtin_pack_vector(a, b)  __builtin_pack_vector_int128 ((a), (b))
+#define __builtin_unpack_vector_0(a) __builtin_unpack_vector_int128 ((vector __int128_t)(a), 0)
+#define __builtin_unpack_vector_1(a) __builtin_unpack_vector_int128 ((vector __int128_t)(a), 1)
+#endif
+
+#include "crc32_reduce.h"
+
+#ifndef CRC32_COMBINE_FUNCTION
+#define CRC32_COMBINE_FUNCTION		crc32_combine
+#endif
+#ifndef CRC32_COMBINE_GEN_FUNCTION
+#define CRC32_COMBINE_GEN_FUNCTION	crc32_combine_gen
+#endif
+#ifndef CRC32_COMBINE_OP_FUNCTION
+#define CRC32_COMBINE_OP_FUNCTION	crc32_combine_op
+#endif
+#ifndef CRC32_ZEROS_FUNCTION
+#define CRC32_ZEROS_FUNCTION		crc32_vpmsum_zeros
+#endif
+
+/* x^0 in the same bit order as the CRC */
+#ifdef REFLECT
+#define CRC_ONE		0x80000000U
+#else
+#define CRC_ONE		0x00000001U
+#endif
+
+/*
+ * Return a(x) * b(x) mod p(x), where a and b are in the same bit order as
+ * the CRC.
+ */
+static unsigned int __attribute__ ((aligned (32)))
+crc32_multiply(unsigned int a, unsigned int b)
+{
+	__vector unsigned long long va, vb;
+
+	va = (__vector unsigned long long)__builtin_pack_vector(0UL,
+		(unsigned long)a);
+	vb = (__vector unsigned long long)__builtin_pack_vector(0UL,
+		(unsigned long)b);
+
+	/*
+	 * a(x) * b(x), at most 63 bits. A reflected product is a 63 bit
+	 * reflected value, which crc32_barrett() shifts up one bit to line
+	 * it up with the 64 bit value the reflected reduction expects.
+	 */
+	return crc32_barrett(__builtin_crypto_vpmsumd(va, vb), v_Barrett_const,
+			     CRC32_REFLECTED);
+}
+
+/* Return the operator to shift a CRC past len2 bytes, x^(8*len2) mod p(x). */
+unsigned int CRC32_COMBINE_GEN_FUNCTION(unsigned long len2)
+{
+	unsigned int op = CRC_ONE;
+	unsigned int k = 0;
+
+	while (len2) {
+		if (len2 & 1)
+			op = crc32_multiply(op, crc_shift_table[k]);
+		len2 >>= 1;
+		k++;
+	}
+
+	return op;
+}
+
+/* Combine crc1 and crc2 with an operator from crc32_combine_gen(len2). */
+unsigned int CRC32_COMBINE_OP_FUNCTION(unsigned int crc1, unsigned int crc2,
+				       unsigned int op)
+{
+	return crc32_multiply(crc1, op) ^ crc2;
+}
+
+/* Return the CRC of A . B, given crc1 = CRC(A), crc2 = CRC(B), len2 = |B| */
+unsigned int CRC32_COMBINE_FUNCTION(unsigned int crc1, unsigned int crc2,
+				    unsigned long len2)
+{
+	return CRC32_COMBINE_OP_FUNCTION(crc1, crc2,
+					 CRC32_COMBINE_GEN_FUNCTION(len2));
+}
+
+/* Return crc32_vpmsum(crc, p, n) where p points to n zero bytes */
+unsigned int CRC32_ZEROS_FUNCTION(unsigned int crc, unsigned long n)
+{
+#ifdef CRC_XOR
+	crc ^= 0xffffffff;
+#endif
+
+	crc = crc32_multiply(crc, CRC32_COMBINE_GEN_FUNCTION(n));
+
+#ifdef CRC_XOR
+	crc ^= 0xffffffff;
+#endif
+
+	return crc;
+}
@@ -0,0 +1,136 @@
+/*
+ * Test combining CRCs of two buffers, and the CRC of runs of zeros.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of either:
+ *
+ *  a) the GNU General Public License as published by the Free Software
+ *     Foundation; either version 2 of the License, or (at your option)
+ *     any later version, or
+ *  b) the Apache License, Version 2.0
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "crcmodel.h"
+#include "crc32_constants.h"
+
+#define MAX_CRC_LENGTH	(64*1024)
+#define ITERATIONS	1000
+
+unsigned int crc32_combine(unsigned int crc1, unsigned int crc2,
+			   unsigned long len2);
+unsigned int crc32_combine_gen(unsigned long len2);
+unsigned int crc32_combine_op(unsigned int crc1, unsigned int crc2,
+			      unsigned int op);
+unsigned int crc32_vpmsum_zeros(unsigned int crc, unsigned long n);
+
+static unsigned int verify_crc(unsigned int crc, unsigned char *p,
+			       unsigned long len)
+{
+	cm_t cm_t = { 0, };
+	int i;
+
+	cm_t.cm_width = 32;
+	cm_t.cm_poly  = CRC;
+	cm_t.cm_init  = crc;
+#ifdef REFLECT
+	cm_t.cm_refin = TRUE;
+	cm_t.cm_refot = TRUE;
+#else
+	cm_t.cm_refin = FALSE;
+	cm_t.cm_refot = FALSE;
+#endif
+#ifdef CRC_XOR
+	cm_t.cm_init ^= 0xffffffff;
+	cm_t.cm_xorot = 0xffffffff;
+#else
+	cm_t.cm_xorot = 0x0;
+#endif
+	cm_ini(&cm_t);
+
+	for (i = 0; i < len; i++)
+		cm_nxt(&cm_t, p[i]);
+
+	return cm_crc(&cm_t);
+}
+
+int main(void)
+{
+	unsigned char *data, *zeros;
+	unsigned long i;
+	int ret = 0;
+
+	data = malloc(MAX_CRC_LENGTH);
+	zeros = calloc(1, MAX_CRC_LENGTH);
+	if (!data || !zeros) {
+		perror("malloc");
+		exit(1);
+	}
+
+	srandom(1);
+
+	for (i = 0; i < MAX_CRC_LENGTH; i++)
+		data[i] = random() & 0xff;
+
+	for (i = 0; i < ITERATIONS; i++) {
+		unsigned long len, len1, len2;
+		unsigned int crc, crc1, crc2, verify, op;
+
+		len = random() % MAX_CRC_LENGTH;
+		len1 = len ? random() % len : 0;
+		len2 = len - len1;
+
+		crc1 = verify_crc(0, data, len1);
+		crc2 = verify_crc(0, data + len1, len2);
+		verify = verify_crc(0, data, len);
+
+		crc = crc32_combine(crc1, crc2, len2);
+		if (crc != verify) {
+			printf("FAILURE: crc32_combine got 0x%08x expected 0x%08x (len1 %lu len2 %lu)\n",
+			       crc, verify, len1, len2);
+			ret = 1;
+		}
+
+		op = crc32_combine_gen(len2);
+		crc = crc32_combine_op(crc1, crc2, op);
+		if (crc != verify) {
+			printf("FAILURE: crc32_combine_op got 0x%08x expected 0x%08x (len1 %lu len2 %lu)\n",
+			       crc, verify, len1, len2);
+			ret = 1;
+		}
+	}
+
+	for (i = 0; i < ITERATIONS; i++) {
+		unsigned long n, n1, n2;
+		unsigned int init, crc, verify;
+
+		n = random() % MAX_CRC_LENGTH;
+		init = random();
+
+		crc = crc32_vpmsum_zeros(init, n);
+		verify = verify_crc(init, zeros, n);
+		if (crc != verify) {
+			printf("FAILURE: crc32_vpmsum_zeros got 0x%08x expected 0x%08x (n %lu)\n",
+			       crc, verify, n);
+			ret = 1;
+		}
+
+		/* Runs too long to check against the model must still split */
+		n1 = ((unsigned long)random() << 31) | random();
+		n2 = ((unsigned long)random() << 31) | random();
+
+		crc = crc32_vpmsum_zeros(crc32_vpmsum_zeros(init, n1), n2);
+		verify = crc32_vpmsum_zeros(init, n1 + n2);
+		if (crc != verify) {
+			printf("FAILURE: crc32_vpmsum_zeros split got 0x%08x expected 0x%08x (n1 %lu n2 %lu)\n",
+			       crc, verify, n1, n2);
+			ret = 1;
+		}
+	}
+
+	free(zeros);
+	free(data);
+
+	return ret;
+}
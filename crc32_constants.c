@@ -22,26 +22,239 @@
  */
 #define BLOCKING	(32*1024)
 
-static void print_header(int argc, char *argv[]) {
-	printf("/*\n");
-	printf("*\n");
-	printf("* THIS FILE IS GENERATED WITH\n");
-	while (argc-- > 0)
-		printf("%s ", argv++[0]);
-	printf("\n\n* This is from https://github.com/antonblanchard/crc32-vpmsum/\n");
-	printf("* DO NOT MODIFY IT MANUALLY!\n");
-	printf("*\n");
-	printf("*/\n\n");
+/*
+ * Data beyond the last block is streamed through the 8 parallel chunks by
+ * folding them forward CRC_FOLD_DISTANCE bits at a time, then the chunks
+ * are combined and reduced. See crc32_fold_constants().
+ */
+static void print_fold_constants(unsigned int crc, int reflected)
+{
+	unsigned long hi[CRC_FOLD_CONSTANTS], lo[CRC_FOLD_CONSTANTS];
+	unsigned int i, n;
+	int le;
+
+	crc32_fold_constants(crc, reflected, hi, lo);
+
+	printf("\n/* Fold 128 bit chunks forward by a fixed distance, "
+		"then reduce the final 128 bits to 64 bits */\n");
+	printf("\nstatic const __vector unsigned long long vcrc_fold_const[%d]\n",
+		CRC_FOLD_CONSTANTS);
+	printf("\t__attribute__((aligned (16))) = {\n");
+
+	for (le = 1; le >= 0; le--) {
+		printf(le ? "#ifdef __LITTLE_ENDIAN__\n" :
+			"#else /* __LITTLE_ENDIAN__ */\n");
+
+		for (i = 0, n = CRC_FOLD_DISTANCE; n >= 128; i++, n /= 2) {
+			if (reflected)
+				printf("\t\t/* x^%u mod p(x)` << 1, x^%u mod p(x)` << 1 */\n",
+					n-32, n+32);
+			else
+				printf("\t\t/* x^%u mod p(x) , x^%u mod p(x) */\n",
+					n+64, n);
+			printf("\t\t{ 0x%016lx, 0x%016lx },\n",
+				le ? lo[i] : hi[i], le ? hi[i] : lo[i]);
+		}
+
+		if (reflected)
+			printf("\t\t/* x^32 mod p(x)` , x^64 mod p(x)` , "
+				"x^96 mod p(x)` , x^128 mod p(x)`  */\n");
+		else
+			printf("\t\t/* x^128 mod p(x) , x^96 mod p(x) , "
+				"x^64 mod p(x) , x^32 mod p(x)  */\n");
+		/* Do not print comma on the last element of the array. */
+		printf("\t\t{ 0x%016lx, 0x%016lx }\n",
+			le ? lo[i] : hi[i], le ? hi[i] : lo[i]);
+	}
+
+	printf("#endif /* __LITTLE_ENDIAN__ */\n");
+	printf("\t};\n");
+}
+
+/*
+ * Constants to shift a 64 bit value (the sum of 32x32 bit products that we
+ * Barrett reduce) by 0-15 bytes: x^(8n+32) mod p(x) for the high word and
+ * x^8n mod p(x) for the low word, so a single vpmsumw does the shift. This
+ * lets us fold a head or tail of under 16 bytes in without the byte table.
+ *
+ * Only the least significant doubleword is populated so the product isn't
+ * summed twice.
+ */
+static void print_shift_constants(unsigned int crc, int reflected)
+{
+	unsigned long k[16];
+	unsigned int n;
+	int le;
+
+	for (n = 0; n < 16; n++) {
+		if (reflected)
+			k[n] = (reflect(get_remainder(crc, 32, 8*n), 32) << 32) |
+				reflect(get_remainder(crc, 32, 8*n+32), 32);
+		else
+			k[n] = (get_remainder(crc, 32, 8*n+32) << 32) |
+				get_remainder(crc, 32, 8*n);
+	}
+
+	printf("\n/* Shift a 64 bit value by 0-15 bytes */\n");
+	printf("\nstatic const __vector unsigned long long vcrc_shift_const[16]\n");
+	printf("\t__attribute__((aligned (16))) = {\n");
+
+	for (le = 1; le >= 0; le--) {
+		printf(le ? "#ifdef __LITTLE_ENDIAN__\n" :
+			"#else /* __LITTLE_ENDIAN__ */\n");
+
+		for (n = 0; n < 16; n++) {
+			if (reflected)
+				printf("\t\t/* x^%u mod p(x)` , x^%u mod p(x)`  */\n",
+					8*n, 8*n+32);
+			else
+				printf("\t\t/* x^%u mod p(x) , x^%u mod p(x)  */\n",
+					8*n+32, 8*n);
+			printf("\t\t{ 0x%016lx, 0x%016lx }%s\n",
+				le ? k[n] : 0UL, le ? 0UL : k[n],
+				n != 15 ? "," : "");
+		}
+	}
+
+	printf("#endif /* __LITTLE_ENDIAN__ */\n");
+	printf("\t};\n");
+}
+
+/*
+ * Constants for the vec_crc32.c main loop with the given number of 128 bit
+ * streams. A row is one 16 byte chunk from each stream; vcrc_const reduces
+ * every row of a block but the last to the last row, and vcrc_short_const
+ * reduces the last row plus up to a row of trailing data (or a buffer of
+ * under two rows) to 64 bits, shifting 32 bits to include the trailing 32
+ * bits of zeros. Data beyond a block is folded forward a row at a time
+ * with vcrc_row_fold_const, which has the same layout as vcrc_fold_const.
+ *
+ * A block is the largest whole number of rows that fits in BLOCKING bytes.
+ */
+static void print_stream_constants(unsigned int crc, int reflected,
+				   unsigned int streams)
+{
+	unsigned int row = streams * 128;
+	unsigned int block = (BLOCKING * 8 / row) * row;
+	unsigned long a, b, c, d;
+	int i, le;
+
+	printf("\n/* Reduce %d kbits to %d bits */", block, row);
+	printf("\nstatic const __vector unsigned long long vcrc_const[%d]\n",
+		block / row - 1);
+	printf("\t__attribute__((aligned (16))) = {\n");
+
+	for (le = 1; le >= 0; le--) {
+		printf(le ? "#ifdef __LITTLE_ENDIAN__\n" :
+			"#else /* __LITTLE_ENDIAN__ */\n");
+
+		for (i = block - row; i > 0; i -= row) {
+			if (reflected) {
+				a = reflect(get_remainder(crc, 32, i), 32) << 1;
+				b = reflect(get_remainder(crc, 32, i+64), 32) << 1;
+				printf("\t\t/* x^%u mod p(x)` << 1, x^%u mod p(x)` << 1 */\n",
+					i, i+64);
+			} else {
+				a = get_remainder(crc, 32, i+64);
+				b = get_remainder(crc, 32, i);
+				printf("\t\t/* x^%u mod p(x), x^%u mod p(x) */\n",
+					i+64, i);
+			}
+			printf("\t\t{ 0x%016lx, 0x%016lx }%s\n",
+				le ? b : a, le ? a : b, i != row ? "," : "");
+		}
+	}
+
+	printf("#endif /* __LITTLE_ENDIAN__ */\n");
+	printf("\t};\n");
+
+	printf("\n/* Reduce final %d-%d bits to 64 bits, shifting 32 bits to "
+		"include the trailing 32 bits of zeros */\n", row, row * 2);
+	printf("\nstatic const __vector unsigned long long vcrc_short_const[%d]\n",
+		(row * 2) / 128);
+	printf("\t__attribute__((aligned (16))) = {\n");
+
+	for (le = 1; le >= 0; le--) {
+		printf(le ? "#ifdef __LITTLE_ENDIAN__\n" :
+			"#else /* __LITTLE_ENDIAN__ */\n");
+
+		for (i = (row * 2) - 128; i >= 0; i -= 128) {
+			if (reflected) {
+				a = reflect(get_remainder(crc, 32, i+32), 32);
+				b = reflect(get_remainder(crc, 32, i+64), 32);
+				c = reflect(get_remainder(crc, 32, i+96), 32);
+				d = reflect(get_remainder(crc, 32, i+128), 32);
+				printf("\t\t/* x^%u mod p(x) , x^%u mod p(x) , "
+					"x^%u mod p(x) , x^%u mod p(x)  */\n",
+					i+32, i+64, i+96, i+128);
+			} else {
+				a = get_remainder(crc, 32, i+128);
+				b = get_remainder(crc, 32, i+96);
+				c = get_remainder(crc, 32, i+64);
+				d = get_remainder(crc, 32, i+32);
+				printf("\t\t/* x^%u mod p(x) , x^%u mod p(x) , "
+					"x^%u mod p(x) , x^%u mod p(x)  */\n",
+					i+128, i+96, i+64, i+32);
+			}
+			if (le)
+				printf("\t\t{ 0x%08lx%08lx, 0x%08lx%08lx }%s\n",
+					c, d, a, b, i != 0 ? "," : "");
+			else
+				printf("\t\t{ 0x%08lx%08lx, 0x%08lx%08lx }%s\n",
+					a, b, c, d, i != 0 ? "," : "");
+		}
+	}
+
+	printf("#endif /* __LITTLE_ENDIAN__ */\n");
+	printf("\t};\n");
+
+	if (reflected) {
+		a = reflect(get_remainder(crc, 32, row-32), 32) << 1;
+		b = reflect(get_remainder(crc, 32, row+32), 32) << 1;
+	} else {
+		a = get_remainder(crc, 32, row+64);
+		b = get_remainder(crc, 32, row);
+	}
+
+	printf("\n/* Fold %d bits forward by a row */\n", row);
+	printf("\nstatic const __vector unsigned long long vcrc_row_fold_const[1]\n");
+	printf("\t__attribute__((aligned (16))) = {\n");
+	printf("#ifdef __LITTLE_ENDIAN__\n");
+	printf("\t\t{ 0x%016lx, 0x%016lx }\n", b, a);
+	printf("#else /* __LITTLE_ENDIAN__ */\n");
+	printf("\t\t{ 0x%016lx, 0x%016lx }\n", a, b);
+	printf("#endif /* __LITTLE_ENDIAN__ */\n");
+	printf("\t};\n");
+}
+
+/*
+ * vec_crc32.c is built with 8 streams unless CRC32_STREAMS says otherwise
+ * (POWER10 uses 16), so emit the tables for each supported count.
+ */
+static const unsigned int stream_counts[] = { 4, 12, 16 };
+
+static void print_all_stream_constants(unsigned int crc, int reflected)
+{
+	unsigned int i;
+
+	printf("\n/* Constants */\n");
+	printf("#if !defined(CRC32_STREAMS) || CRC32_STREAMS == 8\n");
+	print_stream_constants(crc, reflected, 8);
+	for (i = 0; i < sizeof(stream_counts) / sizeof(stream_counts[0]); i++) {
+		printf("#elif CRC32_STREAMS == %u\n", stream_counts[i]);
+		print_stream_constants(crc, reflected, stream_counts[i]);
+	}
+	printf("#else\n");
+	printf("#error \"No constants for CRC32_STREAMS\"\n");
+	printf("#endif /* CRC32_STREAMS */\n");
 }
 
 static void create_table(unsigned int crc, int reflect)
 {
+	unsigned int table[256];
 	int i;
-	cm_t cm_t = { 0, };
 
-	cm_t.cm_width = 32;
-	cm_t.cm_poly = crc;
-	cm_t.cm_refin = reflect;
+	crc32_byte_table(crc, reflect, table);
 
 	printf("#ifdef CRC_TABLE\n");
 	printf("static const unsigned int crc_table[] = {");
@@ -51,17 +264,80 @@ static void create_table(unsigned int crc, int reflect)
 			printf("\n\t");
 		else
 			printf(" ");
-		printf("0x%08lx,", cm_tab(&cm_t, i));
+		printf("0x%08x,", table[i]);
 	}
 
 	printf("};\n\n");
 	printf("#endif /* CRC_TABLE */\n");
 }
 
+/*
+ * Slicing tables: entry i of table k is the CRC of byte i followed by k
+ * zero bytes, so 8 (or 16) bytes can be looked up independently and xored
+ * together. Table 0 is crc_table. Define CRC_SLICE_TABLE to 8 or 16 before
+ * including the header to get that many tables.
+ */
+static void create_slice_table(unsigned int crc, int reflect)
+{
+	unsigned int t[16][256];
+	int i, k;
+
+	crc32_slice_table(crc, reflect, t, 16);
+
+	printf("#ifdef CRC_SLICE_TABLE\n");
+	printf("static const unsigned int crc_slice_table[CRC_SLICE_TABLE][256] = {");
+
+	for (k = 0; k < 16; k++) {
+		if (k == 8)
+			printf("\n#if CRC_SLICE_TABLE > 8");
+		printf("\n{");
+		for (i = 0; i < 256; i++) {
+			if (!(i % 4))
+				printf("\n\t");
+			else
+				printf(" ");
+			printf("0x%08x,", t[k][i]);
+		}
+		printf("\n},");
+	}
+
+	printf("\n#endif\n};\n\n");
+	printf("#endif /* CRC_SLICE_TABLE */\n");
+}
+
+/*
+ * x^(8 * 2^k) mod p(x), ie the constant to shift a CRC past 2^k bytes of
+ * zeros. Any shift can be built from these in O(log n) multiplications,
+ * which is what crc32_combine() does.
+ */
+static void create_shift_table(unsigned int crc, int reflected)
+{
+	uint64_t r;
+	int i;
+
+	printf("#ifdef CRC_SHIFT_TABLE\n");
+	printf("static const unsigned int crc_shift_table[] = {");
+
+	/* x^8 */
+	r = x2kmodp(3, crc, 32);
+	for (i = 0; i < 64; i++) {
+		if (!(i % 4))
+			printf("\n\t");
+		else
+			printf(" ");
+		printf("0x%08lx,", reflected ? reflect(r, 32) : r);
+		r = multmodp(r, r, crc, 32);
+	}
+
+	printf("};\n\n");
+	printf("#endif /* CRC_SHIFT_TABLE */\n");
+}
+
 static void do_nonreflected(unsigned int crc, int xor, int assembler, int p8intrinsics)
 {
 	int i;
 	unsigned long a, b, c, d;
+	unsigned long k[2];
 
 	printf("#define CRC 0x%x\n", crc);
 	if (xor)
@@ -69,106 +345,45 @@ static void do_nonreflected(unsigned int crc, int xor, int assembler, int p8intr
 	printf("#define MAX_SIZE    %d\n", BLOCKING);
 	printf("\n#ifndef __ASSEMBLER__\n");
 	create_table(crc, 0);
+	create_slice_table(crc, 0);
+	create_shift_table(crc, 0);
 
 	if (!p8intrinsics)
 		goto skip_p8_intrinsics;
 
 	/* Generate vector constants. */
 	printf("#ifdef POWER8_INTRINSICS\n");
-	printf("\n/* Constants */\n");
-	printf("\n/* Reduce %d kbits to 1024 bits */", BLOCKING*8);
-	printf("\nstatic const __vector unsigned long long vcrc_const[%d]\n",
-		((BLOCKING*8)/1024)-1);
-	printf("\t__attribute__((aligned (16))) = {\n");
-	printf("#ifdef __LITTLE_ENDIAN__\n");
-	for (i = (BLOCKING*8)-1024; i > 0; i -= 1024) {
-		a = get_remainder(crc, 32, i+64);
-		b = get_remainder(crc, 32, i);
-		/* Print two remainders. */
-		printf("\t\t/* x^%u mod p(x)` , x^%u mod p(x)` */\n", i+64, i);
-		if (i != 1024) {
-			printf("\t\t{ 0x%016lx, 0x%016lx },\n", b, a);
-		} else {
-			/* Do not print comma on the last element of the array. */
-			printf("\t\t{ 0x%016lx, 0x%016lx }\n", b, a);
-		}
-	}
-	printf("#else /* __LITTLE_ENDIAN__ */\n");
-	for (i = (BLOCKING*8)-1024; i > 0; i -= 1024) {
-		a = get_remainder(crc, 32, i+64);
-		b = get_remainder(crc, 32, i);
-		/* Print two remainders. */
-		printf("\t\t/* x^%u mod p(x)` , x^%u mod p(x)` */\n", i+64, i);
-		if (i != 1024) {
-			printf("\t\t{ 0x%016lx, 0x%016lx },\n", a, b);
-		} else {
-			/* Do not print comma on the last element of the array. */
-			printf("\t\t{ 0x%016lx, 0x%016lx }\n", a, b);
-		}
-	}
-	printf("#endif /* __LITTLE_ENDIAN__ */\n");
-	printf("\t};\n");
-
-
-	printf("\n/* Reduce final 1024-2048 bits to 64 bits, shifting 32 bits to "
-		"include the trailing 32 bits of zeros */\n");
-	printf("\nstatic const __vector unsigned long long vcrc_short_const[%d]\n",
-		((1024*2)/128));
-	printf("\t__attribute__((aligned (16))) = {\n");
-	printf("#ifdef __LITTLE_ENDIAN__\n");
-	for (i = (1024*2)-128; i >= 0; i -= 128) {
-		a = get_remainder(crc, 32, i+128);
-		b = get_remainder(crc, 32, i+96);
-		c = get_remainder(crc, 32, i+64);
-		d = get_remainder(crc, 32, i+32);
-
-		/* Print four remainders. */
-		printf("\t\t/* x^%u mod p(x) , x^%u mod p(x) , x^%u mod p(x) , "
-			"x^%u mod p(x)  */\n", i+128, i+96, i+64, i+32);
-		if (i != 0) {
-			printf("\t\t{ 0x%08lx%08lx, 0x%08lx%08lx },\n", c, d, a, b);
-		} else {
-			/* Do not print comma on the last element of the array. */
-			printf("\t\t{ 0x%08lx%08lx, 0x%08lx%08lx }\n", c, d, a, b);
-		}
-	}
-	printf("#else /* __LITTLE_ENDIAN__ */\n");
-	for (i = (1024*2)-128; i >= 0; i -= 128) {
-		a = get_remainder(crc, 32, i+128);
-		b = get_remainder(crc, 32, i+96);
-		c = get_remainder(crc, 32, i+64);
-		d = get_remainder(crc, 32, i+32);
-
-		/* Print four remainders. */
-		printf("\t\t/* x^%u mod p(x) , x^%u mod p(x) , x^%u mod p(x) , "
-			"x^%u mod p(x)  */\n", i+128, i+96, i+64, i+32);
-		if (i != 0) {
-			printf("\t\t{ 0x%08lx%08lx, 0x%08lx%08lx },\n", a, b, c, d);
-		} else {
-			/* Do not print comma on the last element of the array. */
-			printf("\t\t{ 0x%08lx%08lx, 0x%08lx%08lx }\n", a, b, c, d);
-		}
-	}
-	printf("#endif /* __LITTLE_ENDIAN__ */\n");
-	printf("\t};\n");
+	print_all_stream_constants(crc, 0);
+	printf("#endif /* POWER8_INTRINSICS */\n\n");
 
+	printf("#if defined(POWER8_INTRINSICS) || defined(POWER8_FOLD_INTRINSICS) || \\\n"
+		"    defined(POWER8_BARRETT_INTRINSICS)\n");
 	printf("\n/* Barrett constants */\n");
 	printf("/* 33 bit reflected Barrett constant m - (4^32)/n */\n");
 	printf("\nstatic const __vector unsigned long long v_Barrett_const[%d]\n"
 		, 2);
 	printf("\t__attribute__((aligned (16))) = {\n");
 	/* Print quotient and Barrett constant. */
+	crc32_barrett_constants(crc, 0, k);
 	printf("\t\t/* x^%u div p(x)  */\n", 64);
 	printf("#ifdef __LITTLE_ENDIAN__\n");
-	printf("\t\t{ 0x%016lx, 0x%016lx },\n", get_quotient(crc, 32, 64), 0UL);
-	printf("\t\t{ 0x%016lx, 0x%016lx }\n", (1UL << 32) | crc, 0UL);
+	printf("\t\t{ 0x%016lx, 0x%016lx },\n", k[0], 0UL);
+	printf("\t\t{ 0x%016lx, 0x%016lx }\n", k[1], 0UL);
 	printf("#else /* __LITTLE_ENDIAN__ */\n");
-	printf("\t\t{ 0x%016lx, 0x%016lx },\n", 0UL, get_quotient(crc, 32, 64));
-	printf("\t\t{ 0x%016lx, 0x%016lx }\n", 0UL, (1UL << 32) | crc);
+	printf("\t\t{ 0x%016lx, 0x%016lx },\n", 0UL, k[0]);
+	printf("\t\t{ 0x%016lx, 0x%016lx }\n", 0UL, k[1]);
 	printf("#endif /* __LITTLE_ENDIAN__ */\n");
 	printf("\t};\n");
+	printf("#endif /* POWER8_INTRINSICS || POWER8_FOLD_INTRINSICS || "
+		"POWER8_BARRETT_INTRINSICS */\n\n");
 
-	printf("#endif /* POWER8_INTRINSICS */\n\n");
+	printf("#if defined(POWER8_INTRINSICS) || defined(POWER8_FOLD_INTRINSICS)\n");
+	print_fold_constants(crc, 0);
+	printf("#endif /* POWER8_INTRINSICS || POWER8_FOLD_INTRINSICS */\n\n");
+
+	printf("#if defined(POWER8_INTRINSICS) || defined(POWER8_SHIFT_INTRINSICS)\n");
+	print_shift_constants(crc, 0);
+	printf("#endif /* POWER8_INTRINSICS || POWER8_SHIFT_INTRINSICS */\n\n");
 
 skip_p8_intrinsics:
 
@@ -207,6 +422,12 @@ skip_p8_intrinsics:
 	printf("\t/* Barrett constant n */\n");
 	printf("\t.octa 0x%032lx\n", (1UL << 32) | crc);
 
+	printf("\n.fold_constants:\n");
+	printf("\t/* Fold 1024 bits forward by %d bits */\n", CRC_FOLD_DISTANCE);
+	a = get_remainder(crc, 32, CRC_FOLD_DISTANCE+64);
+	b = get_remainder(crc, 32, CRC_FOLD_DISTANCE);
+	print_two_remainders(a, CRC_FOLD_DISTANCE+64, b, CRC_FOLD_DISTANCE, "");
+
 skip_assembler:
 
 	printf("#endif /* __ASSEMBLER__ */\n");
@@ -216,6 +437,7 @@ static void do_reflected(unsigned int crc, int xor, int assembler, int p8intrins
 {
 	int i;
 	unsigned long a, b, c, d;
+	unsigned long k[2];
 
 	printf("#define CRC 0x%x\n", crc);
 	if (xor)
@@ -224,108 +446,45 @@ static void do_reflected(unsigned int crc, int xor, int assembler, int p8intrins
 	printf("#define MAX_SIZE    %d\n", BLOCKING);
 	printf("\n#ifndef __ASSEMBLER__\n");
 	create_table(crc, 1);
+	create_slice_table(crc, 1);
+	create_shift_table(crc, 1);
 	/* Generate vector constants (reflected). */
 
 	if (!p8intrinsics)
 		goto skip_p8_intrinsics;
 
 	printf("#ifdef POWER8_INTRINSICS\n");
-	printf("\n/* Constants */\n");
-	printf("\n/* Reduce %d kbits to 1024 bits */", BLOCKING*8);
-	printf("\nstatic const __vector unsigned long long vcrc_const[%d]\n",
-		((BLOCKING*8)/1024)-1);
-	printf("\t__attribute__((aligned (16))) = {\n");
-	printf("#ifdef __LITTLE_ENDIAN__\n");
-	for (i = (BLOCKING*8)-1024; i > 0; i -= 1024) {
-		a = reflect(get_remainder(crc, 32, i), 32) << 1;
-		b = reflect(get_remainder(crc, 32, i+64), 32) << 1;
-
-		/* Print two remainders. */
-		printf("\t\t/* x^%u mod p(x)` << 1, x^%u mod p(x)` << 1 */\n", i, i+64);
-		if (i != 1024) {
-			printf("\t\t{ 0x%016lx, 0x%016lx },\n", b, a);
-		} else {
-			/* Do not print comma on the last element of the array. */
-			printf("\t\t{ 0x%016lx, 0x%016lx }\n", b, a);
-		}
-	}
-	printf("#else /* __LITTLE_ENDIAN__ */\n");
-	for (i = (BLOCKING*8)-1024; i > 0; i -= 1024) {
-		a = reflect(get_remainder(crc, 32, i), 32) << 1;
-		b = reflect(get_remainder(crc, 32, i+64), 32) << 1;
-
-		/* Print two remainders. */
-		printf("\t\t/* x^%u mod p(x)` << 1, x^%u mod p(x)` << 1 */\n", i, i+64);
-		if (i != 1024) {
-			printf("\t\t{ 0x%016lx, 0x%016lx },\n", a, b);
-		} else {
-			/* Do not print comma on the last element of the array. */
-			printf("\t\t{ 0x%016lx, 0x%016lx }\n", a, b);
-		}
-	}
-	printf("#endif /* __LITTLE_ENDIAN__ */\n");
-	printf("\t};\n");
-
-
-	printf("\n/* Reduce final 1024-2048 bits to 64 bits, shifting 32 bits to "
-		"include the trailing 32 bits of zeros */\n");
-	printf("\nstatic const __vector unsigned long long vcrc_short_const[%d]\n",
-		((1024*2)/128));
-	printf("\t__attribute__((aligned (16))) = {\n");
-	printf("#ifdef __LITTLE_ENDIAN__\n");
-	for (i = (1024*2)-128; i >= 0; i -= 128) {
-		a = reflect(get_remainder(crc, 32, i+32), 32);
-		b = reflect(get_remainder(crc, 32, i+64), 32);
-		c = reflect(get_remainder(crc, 32, i+96), 32);
-		d = reflect(get_remainder(crc, 32, i+128), 32);
-
-		/* Print four remainders. */
-		printf("\t\t/* x^%u mod p(x) , x^%u mod p(x) , x^%u mod p(x) , "
-			"x^%u mod p(x)  */\n", i+32, i+64, i+96, i+128);
-		if (i != 0) {
-			printf("\t\t{ 0x%08lx%08lx, 0x%08lx%08lx },\n", c, d, a, b);
-		} else {
-			/* Do not print comma on the last element of the array. */
-			printf("\t\t{ 0x%08lx%08lx, 0x%08lx%08lx }\n", c, d, a, b);
-		}
-	}
-	printf("#else /* __LITTLE_ENDIAN__ */\n");
-	for (i = (1024*2)-128; i >= 0; i -= 128) {
-		a = reflect(get_remainder(crc, 32, i+32), 32);
-		b = reflect(get_remainder(crc, 32, i+64), 32);
-		c = reflect(get_remainder(crc, 32, i+96), 32);
-		d = reflect(get_remainder(crc, 32, i+128), 32);
-
-		/* Print four remainders. */
-		printf("\t\t/* x^%u mod p(x) , x^%u mod p(x) , x^%u mod p(x) , "
-			"x^%u mod p(x)  */\n", i+32, i+64, i+96, i+128);
-		if (i != 0) {
-			printf("\t\t{ 0x%08lx%08lx, 0x%08lx%08lx },\n", a, b, c, d);
-		} else {
-			/* Do not print comma on the last element of the array. */
-			printf("\t\t{ 0x%08lx%08lx, 0x%08lx%08lx }\n", a, b, c, d);
-		}
-	}
-	printf("#endif /* __LITTLE_ENDIAN__ */\n");
-	printf("\t};\n");
+	print_all_stream_constants(crc, 1);
+	printf("#endif /* POWER8_INTRINSICS */\n\n");
 
+	printf("#if defined(POWER8_INTRINSICS) || defined(POWER8_FOLD_INTRINSICS) || \\\n"
+		"    defined(POWER8_BARRETT_INTRINSICS)\n");
 	printf("\n/* Barrett constants */\n");
 	printf("/* 33 bit reflected Barrett constant m - (4^32)/n */\n");
 	printf("\nstatic const __vector unsigned long long v_Barrett_const[%d]\n"
 		, 2);
 	printf("\t__attribute__((aligned (16))) = {\n");
 	/* Print quotient and Barrett constant. */
+	crc32_barrett_constants(crc, 1, k);
 	printf("\t\t/* x^%u div p(x)  */\n", 64);
 	printf("#ifdef __LITTLE_ENDIAN__\n");
-	printf("\t\t{ 0x%016lx, 0x%016lx },\n", reflect(get_quotient(crc, 32, 64), 33), 0UL);
-	printf("\t\t{ 0x%016lx, 0x%016lx }\n", reflect((1UL << 32) | crc, 33), 0UL);
+	printf("\t\t{ 0x%016lx, 0x%016lx },\n", k[0], 0UL);
+	printf("\t\t{ 0x%016lx, 0x%016lx }\n", k[1], 0UL);
 	printf("#else /* __LITTLE_ENDIAN__ */\n");
-	printf("\t\t{ 0x%016lx, 0x%016lx },\n", 0UL, reflect(get_quotient(crc, 32, 64),33));
-	printf("\t\t{ 0x%016lx, 0x%016lx }\n", 0UL, reflect((1UL << 32) | crc, 33));
+	printf("\t\t{ 0x%016lx, 0x%016lx },\n", 0UL, k[0]);
+	printf("\t\t{ 0x%016lx, 0x%016lx }\n", 0UL, k[1]);
 	printf("#endif /* __LITTLE_ENDIAN__ */\n");
 	printf("\t};\n");
+	printf("#endif /* POWER8_INTRINSICS || POWER8_FOLD_INTRINSICS || "
+		"POWER8_BARRETT_INTRINSICS */\n\n");
 
-	printf("#endif /* POWER8_INTRINSICS */\n\n");
+	printf("#if defined(POWER8_INTRINSICS) || defined(POWER8_FOLD_INTRINSICS)\n");
+	print_fold_constants(crc, 1);
+	printf("#endif /* POWER8_INTRINSICS || POWER8_FOLD_INTRINSICS */\n\n");
+
+	printf("#if defined(POWER8_INTRINSICS) || defined(POWER8_SHIFT_INTRINSICS)\n");
+	print_shift_constants(crc, 1);
+	printf("#endif /* POWER8_INTRINSICS || POWER8_SHIFT_INTRINSICS */\n\n");
 
 skip_p8_intrinsics:
 
@@ -364,6 +523,12 @@ skip_p8_intrinsics:
 	printf("\t/* 33 bit reflected Barrett constant n */\n");
 	printf("\t.octa 0x%032lx\n", reflect((1UL << 32) | crc, 33));
 
+	printf("\n.fold_constants:\n");
+	printf("\t/* Fold 1024 bits forward by %d bits */\n", CRC_FOLD_DISTANCE);
+	a = reflect(get_remainder(crc, 32, CRC_FOLD_DISTANCE-32), 32) << 1;
+	b = reflect(get_remainder(crc, 32, CRC_FOLD_DISTANCE+32), 32) << 1;
+	print_two_remainders(a, CRC_FOLD_DISTANCE-32, b, CRC_FOLD_DISTANCE+32, "` << 1");
+
 skip_assembler:
 
 	printf("#endif /* __ASSEMBLER__ */\n");
@@ -371,10 +536,8 @@ skip_assembler:
 
 static void usage(char *argv[])
 {
-	fprintf(stderr, "Usage: %s {-r} {-x} CRC\n", argv[0]);
-	fprintf(stderr, "\tCRC without top bit\n");
-	fprintf(stderr, "\t-r bit reflect\n");
-	fprintf(stderr, "\t-x xor input and ouput\n");
+	print_usage(argv);
+	fprintf(stderr, "\t-w width of a CRC under 32 bits, eg 16\n");
 	fprintf(stderr, "\t-a generate constants for assembler implementaiton\n");
 	fprintf(stderr, "\t-c generate constants for P8 intrinsics (C) implementation\n");
 	fprintf(stderr, "Without -a or -c - both will be generated\n");
@@ -387,10 +550,11 @@ int main(int argc, char *argv[])
 	int xor = 0;
 	int p8intrinsics = 0;
 	int assembler = 0;
+	unsigned int width = 32;
 	unsigned int crc;
 
 	while (1) {
-		signed char c = getopt(argc, argv, "rxac");
+		signed char c = getopt(argc, argv, "rxacw:");
 		if (c < 0)
 			break;
 
@@ -411,6 +575,10 @@ int main(int argc, char *argv[])
 			assembler = 1;
 			break;
 
+		case 'w':
+			width = strtoul(optarg, NULL, 0);
+			break;
+
 		default:
 			usage(argv);
 			exit(1);
@@ -423,9 +591,29 @@ int main(int argc, char *argv[])
 		exit(1);
 	}
 
-	crc = strtoul(argv[optind], NULL, 0);
+	if (width < 8 || width > 32) {
+		fprintf(stderr, "Width must be between 8 and 32 bits\n");
+		exit(1);
+	}
+
+	/*
+	 * A CRC of width w with polynomial p(x) is the top w bits of the 32
+	 * bit CRC with polynomial p(x) * x^(32-w), when the initial value is
+	 * shifted up the same way. Reflected, the CRC sits in the bottom w
+	 * bits instead. Either way the other bits must be 0, so inverting
+	 * all 32 bits doesn't work: the caller has to apply any xor.
+	 */
+	if (width < 32 && xor) {
+		fprintf(stderr, "-x is only supported for 32 bit CRCs\n");
+		exit(1);
+	}
+
+	crc = strtoul(argv[optind], NULL, 0) << (32 - width);
 	print_header(argc, argv);
 
+	if (width < 32)
+		printf("#define CRC_WIDTH %u\n", width);
+
 	/* neither specified so use both */
 	if (assembler == 0 && p8intrinsics == 0) assembler = p8intrinsics = 1;
 
@@ -0,0 +1,148 @@
+/*
+ * Pick a crc32_vpmsum implementation once, at load time, based on what the
+ * CPU supports: the POWER10 or POWER9 builds of vec_crc32.c on ISA 3.1 and
+ * 3.0 machines, the vpmsum kernels on POWER8, or a slice by 16 table
+ * driven CRC on older machines.
+ *
+ * This file must be built without -mcpu=power8 (see the Makefile) since it
+ * runs before we know which instructions are available. The kernels it
+ * dispatches to are built as usual and renamed:
+ *
+ * crc32_vpmsum_p10:	vec_crc32.c built with -mcpu=power10
+ * crc32_vpmsum_p9:	vec_crc32.c built with -mcpu=power9
+ * crc32_vpmsum_asm:	crc32_wrapper.c + crc32.S
+ * crc32_vpmsum_c:	vec_crc32.c, used instead of the assembly kernel when
+ *			built with -D CRC32_DISPATCH_INTRINSICS
+ *
+ * By default the choice is made with a GNU ifunc. Build with
+ * -D CRC32_NO_IFUNC on toolchains without ifunc support to resolve through
+ * a function pointer on the first call instead.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of either:
+ *
+ *  a) the GNU General Public License as published by the Free Software
+ *     Foundation; either version 2 of the License, or (at your option)
+ *     any later version, or
+ *  b) the Apache License, Version 2.0
+ */
+#include <sys/auxv.h>
+
+#define CRC_SLICE_TABLE 16
+
+#ifdef CRC32_CONSTANTS_HEADER
+#include CRC32_CONSTANTS_HEADER
+#else
+#include "crc32_constants.h"
+#endif
+
+#include "crc32_slice.h"
+
+#ifndef PPC_FEATURE2_VEC_CRYPTO
+#define PPC_FEATURE2_VEC_CRYPTO	0x02000000
+#endif
+
+#ifndef PPC_FEATURE2_ARCH_3_1
+#define PPC_FEATURE2_ARCH_3_1	0x00040000
+#endif
+
+#ifndef PPC_FEATURE2_ARCH_3_00
+#define PPC_FEATURE2_ARCH_3_00	0x00800000
+#endif
+
+#ifndef AT_HWCAP2
+#define AT_HWCAP2	26
+#endif
+
+#ifndef CRC32_FUNCTION
+#define CRC32_FUNCTION		crc32_vpmsum
+#endif
+#ifndef CRC32_ASM_FUNCTION
+#define CRC32_ASM_FUNCTION	crc32_vpmsum_asm
+#endif
+#ifndef CRC32_P10_FUNCTION
+#define CRC32_P10_FUNCTION	crc32_vpmsum_p10
+#endif
+#ifndef CRC32_P9_FUNCTION
+#define CRC32_P9_FUNCTION	crc32_vpmsum_p9
+#endif
+#ifndef CRC32_C_FUNCTION
+#define CRC32_C_FUNCTION	crc32_vpmsum_c
+#endif
+
+typedef unsigned int (*crc32_func_t)(unsigned int crc, unsigned char *p,
+				     unsigned long len);
+
+unsigned int CRC32_P10_FUNCTION(unsigned int crc, unsigned char *p,
+				unsigned long len);
+unsigned int CRC32_P9_FUNCTION(unsigned int crc, unsigned char *p,
+			       unsigned long len);
+
+#ifdef CRC32_DISPATCH_INTRINSICS
+unsigned int CRC32_C_FUNCTION(unsigned int crc, unsigned char *p,
+			      unsigned long len);
+#define CRC32_VPMSUM_FUNCTION	CRC32_C_FUNCTION
+#else
+unsigned int CRC32_ASM_FUNCTION(unsigned int crc, unsigned char *p,
+				unsigned long len);
+#define CRC32_VPMSUM_FUNCTION	CRC32_ASM_FUNCTION
+#endif
+
+static unsigned int crc32_table(unsigned int crc, unsigned char *p,
+				unsigned long len)
+{
+#ifdef CRC_XOR
+	crc ^= 0xffffffff;
+#endif
+
+	crc = crc32_align(crc, p, len);
+
+#ifdef CRC_XOR
+	crc ^= 0xffffffff;
+#endif
+
+	return crc;
+}
+
+static crc32_func_t crc32_resolve(void)
+{
+	unsigned long hwcap2 = getauxval(AT_HWCAP2);
+
+	if ((hwcap2 & PPC_FEATURE2_ARCH_3_1) &&
+	    (hwcap2 & PPC_FEATURE2_VEC_CRYPTO))
+		return CRC32_P10_FUNCTION;
+
+	if ((hwcap2 & PPC_FEATURE2_ARCH_3_00) &&
+	    (hwcap2 & PPC_FEATURE2_VEC_CRYPTO))
+		return CRC32_P9_FUNCTION;
+
+	if (hwcap2 & PPC_FEATURE2_VEC_CRYPTO)
+		return CRC32_VPMSUM_FUNCTION;
+
+	return crc32_table;
+}
+
+#ifdef CRC32_NO_IFUNC
+static unsigned int crc32_first_call(unsigned int crc, unsigned char *p,
+				     unsigned long len);
+
+static crc32_func_t crc32_impl = crc32_first_call;
+
+static unsigned int crc32_first_call(unsigned int crc, unsigned char *p,
+				     unsigned long len)
+{
+	crc32_impl = crc32_resolve();
+
+	return crc32_impl(crc, p, len);
+}
+
+unsigned int CRC32_FUNCTION(unsigned int crc, unsigned char *p,
+			    unsigned long len)
+{
+	return crc32_impl(crc, p, len);
+}
+#else
+unsigned int CRC32_FUNCTION(unsigned int crc, unsigned char *p,
+			    unsigned long len)
+	__attribute__ ((ifunc ("crc32_resolve")));
+#endif
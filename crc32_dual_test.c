@@ -0,0 +1,120 @@
+/*
+ * Test checksumming with two polynomials at once against the reference
+ * model.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of either:
+ *
+ *  a) the GNU General Public License as published by the Free Software
+ *     Foundation; either version 2 of the License, or (at your option)
+ *     any later version, or
+ *  b) the Apache License, Version 2.0
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include "crcmodel.h"
+
+#ifndef CRC32_DUAL_HEADER1
+#define CRC32_DUAL_HEADER1	"crc32_ethernet_constants.h"
+#endif
+#ifndef CRC32_DUAL_HEADER2
+#define CRC32_DUAL_HEADER2	"crc32_constants.h"
+#endif
+
+#include CRC32_DUAL_HEADER1
+static const unsigned int crc1_poly = CRC;
+#undef CRC
+#undef CRC_XOR
+#undef REFLECT
+#undef MAX_SIZE
+
+#include CRC32_DUAL_HEADER2
+static const unsigned int crc2_poly = CRC;
+
+#define MAX_CRC_LENGTH	70000
+#define ITERATIONS	2000
+
+void crc32_vpmsum_dual(unsigned int *crc1, unsigned int *crc2,
+		       const unsigned char *p, unsigned long len);
+
+static unsigned int verify_crc(unsigned int poly, unsigned int crc,
+			       const unsigned char *p, unsigned long len)
+{
+	cm_t cm_t = { 0, };
+	int i;
+
+	cm_t.cm_width = 32;
+	cm_t.cm_poly  = poly;
+	cm_t.cm_init  = crc;
+#ifdef REFLECT
+	cm_t.cm_refin = TRUE;
+	cm_t.cm_refot = TRUE;
+#else
+	cm_t.cm_refin = FALSE;
+	cm_t.cm_refot = FALSE;
+#endif
+#ifdef CRC_XOR
+	cm_t.cm_init ^= 0xffffffff;
+	cm_t.cm_xorot = 0xffffffff;
+#else
+	cm_t.cm_xorot = 0x0;
+#endif
+	cm_ini(&cm_t);
+
+	for (i = 0; i < len; i++)
+		cm_nxt(&cm_t, p[i]);
+
+	return cm_crc(&cm_t);
+}
+
+int main(void)
+{
+	unsigned char *data;
+	unsigned long i, size;
+	int ret = 0;
+
+	size = MAX_CRC_LENGTH + 16;
+	data = malloc(size);
+	if (!data) {
+		perror("malloc");
+		exit(1);
+	}
+
+	srandom(1);
+
+	for (i = 0; i < size; i++)
+		data[i] = random() & 0xff;
+
+	for (i = 0; i < ITERATIONS; i++) {
+		const unsigned char *p = data + random() % 16;
+		unsigned int init1, init2, crc1, crc2, verify1, verify2;
+		unsigned long len;
+
+		/* Favour the short lengths, where the edge cases are */
+		len = random() % (i % 16 ? 1000 : MAX_CRC_LENGTH);
+
+		init1 = crc1 = random();
+		init2 = crc2 = random();
+
+		crc32_vpmsum_dual(&crc1, &crc2, p, len);
+
+		verify1 = verify_crc(crc1_poly, init1, p, len);
+		verify2 = verify_crc(crc2_poly, init2, p, len);
+
+		if (crc1 != verify1) {
+			printf("FAILURE: first polynomial got 0x%08x expected 0x%08x (len %lu)\n",
+			       crc1, verify1, len);
+			ret = 1;
+		}
+
+		if (crc2 != verify2) {
+			printf("FAILURE: second polynomial got 0x%08x expected 0x%08x (len %lu)\n",
+			       crc2, verify2, len);
+			ret = 1;
+		}
+	}
+
+	free(data);
+
+	return ret;
+}
@@ -0,0 +1,145 @@
+/*
+ * Print the CRC of each file given on the command line.
+ *
+ * Holes in sparse files are found with SEEK_DATA and SEEK_HOLE and
+ * checksummed with crc32_vpmsum_zeros() instead of being read, so a
+ * mostly empty image costs O(log n) per hole rather than a pass over
+ * megabytes of zeros. Filesystems without hole support report the whole
+ * file as data, which just falls back to reading it.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of either:
+ *
+ *  a) the GNU General Public License as published by the Free Software
+ *     Foundation; either version 2 of the License, or (at your option)
+ *     any later version, or
+ *  b) the Apache License, Version 2.0
+ */
+#define _GNU_SOURCE
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+#define BUF_SIZE	(1024*1024)
+
+unsigned int crc32_vpmsum(unsigned int crc, unsigned char *p, unsigned long len);
+unsigned int crc32_vpmsum_zeros(unsigned int crc, unsigned long n);
+
+/*
+ * Checksum len bytes of data at off. Returns -1 with errno set on a read
+ * error, or 1 if the file ends early because it shrank under us.
+ */
+static int crc32_read(int fd, unsigned int *crc, unsigned char *buf,
+		      off_t off, off_t len)
+{
+	while (len) {
+		ssize_t n = pread(fd, buf, len < BUF_SIZE ? len : BUF_SIZE, off);
+
+		if (n < 0) {
+			if (errno == EINTR)
+				continue;
+			return -1;
+		}
+
+		/* Truncated under us */
+		if (n == 0)
+			return 1;
+
+		*crc = crc32_vpmsum(*crc, buf, n);
+		off += n;
+		len -= n;
+	}
+
+	return 0;
+}
+
+/* Returns 0 on success, or as crc32_read() */
+static int crc32_file(int fd, unsigned int *crc, unsigned char *buf)
+{
+	struct stat st;
+	off_t off = 0, data, hole;
+	int ret;
+
+	if (fstat(fd, &st))
+		return -1;
+
+	while (off < st.st_size) {
+		data = lseek(fd, off, SEEK_DATA);
+		if (data < 0) {
+			/* Only a hole left */
+			if (errno == ENXIO)
+				data = st.st_size;
+			else if (errno == EINVAL)
+				data = off;	/* no SEEK_DATA, read it all */
+			else
+				return -1;
+		}
+
+		if (data > off) {
+			*crc = crc32_vpmsum_zeros(*crc, data - off);
+			off = data;
+		}
+
+		if (off >= st.st_size)
+			break;
+
+		hole = lseek(fd, off, SEEK_HOLE);
+		if (hole < 0)
+			hole = st.st_size;
+
+		ret = crc32_read(fd, crc, buf, off, hole - off);
+		if (ret)
+			return ret;
+		off = hole;
+	}
+
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned char *buf;
+	int i, ret = 0;
+
+	if (argc < 2) {
+		fprintf(stderr, "Usage: %s file...\n", argv[0]);
+		exit(1);
+	}
+
+	buf = malloc(BUF_SIZE);
+	if (!buf) {
+		perror("malloc");
+		exit(1);
+	}
+
+	for (i = 1; i < argc; i++) {
+		unsigned int crc = 0;
+		int fd, err = -1;
+
+		fd = open(argv[i], O_RDONLY);
+		if (fd >= 0)
+			err = crc32_file(fd, &crc, buf);
+
+		if (err < 0) {
+			perror(argv[i]);
+			ret = 1;
+		} else if (err) {
+			fprintf(stderr, "%s: file shrank while being read\n",
+				argv[i]);
+			ret = 1;
+		} else {
+			printf("%08x  %s\n", crc, argv[i]);
+		}
+
+		if (fd >= 0)
+			close(fd);
+	}
+
+	free(buf);
+
+	return ret;
+}
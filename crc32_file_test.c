@@ -0,0 +1,119 @@
+/*
+ * Create a set of sparse files and print the CRC of each, in the format
+ * crc32_file uses, so make test can compare the two. The expected CRC is
+ * crc32_vpmsum() over the whole file contents, holes included, so this
+ * checks the SEEK_DATA/SEEK_HOLE walk and crc32_vpmsum_zeros() against a
+ * plain read. Filesystems without hole support still get the same
+ * answer, just without the holes.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of either:
+ *
+ *  a) the GNU General Public License as published by the Free Software
+ *     Foundation; either version 2 of the License, or (at your option)
+ *     any later version, or
+ *  b) the Apache License, Version 2.0
+ */
+#include <sys/types.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#define MB		(1024*1024)
+
+unsigned int crc32_vpmsum(unsigned int crc, unsigned char *p, unsigned long len);
+
+/* Up to 3 extents of data, and the size of the file */
+struct layout {
+	struct {
+		unsigned long off;
+		unsigned long len;
+	} data[3];
+	unsigned long size;
+};
+
+static const struct layout layouts[] = {
+	/* empty */
+	{ { { 0, 0 } }, 0 },
+	/* data only, more than one read buffer */
+	{ { { 0, 3*MB + 123 } }, 3*MB + 123 },
+	/* hole only */
+	{ { { 0, 0 } }, 5*MB },
+	/* leading hole */
+	{ { { 2*MB, 100000 } }, 2*MB + 100000 },
+	/* data, hole, data, trailing hole */
+	{ { { 0, 100000 }, { 3*MB, 5000 } }, 4*MB + 17 },
+	/* small unaligned extents between holes */
+	{ { { 1*MB + 3, 1 }, { 2*MB + 4095, 33 }, { 4*MB - 7, 7 } }, 4*MB },
+};
+
+static int create_file(const char *name, const struct layout *l,
+		       unsigned char *contents)
+{
+	int fd, i;
+
+	fd = open(name, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0)
+		return -1;
+
+	memset(contents, 0, l->size);
+
+	for (i = 0; i < 3 && l->data[i].len; i++) {
+		unsigned char *p = contents + l->data[i].off;
+		unsigned long j;
+
+		for (j = 0; j < l->data[i].len; j++)
+			p[j] = random() & 0xff;
+
+		if (pwrite(fd, p, l->data[i].len, l->data[i].off) !=
+		    l->data[i].len) {
+			close(fd);
+			return -1;
+		}
+	}
+
+	if (ftruncate(fd, l->size)) {
+		close(fd);
+		return -1;
+	}
+
+	return close(fd);
+}
+
+int main(int argc, char *argv[])
+{
+	unsigned char *contents;
+	char name[4096];
+	unsigned int i;
+
+	if (argc != 2) {
+		fprintf(stderr, "Usage: %s prefix\n", argv[0]);
+		exit(1);
+	}
+
+	contents = malloc(8*MB);
+	if (!contents) {
+		perror("malloc");
+		exit(1);
+	}
+
+	srandom(1);
+
+	for (i = 0; i < sizeof(layouts) / sizeof(layouts[0]); i++) {
+		snprintf(name, sizeof(name), "%s.%u", argv[1], i);
+
+		if (create_file(name, &layouts[i], contents)) {
+			perror(name);
+			exit(1);
+		}
+
+		printf("%08x  %s\n", crc32_vpmsum(0, contents, layouts[i].size),
+		       name);
+	}
+
+	free(contents);
+
+	return 0;
+}
@@ -0,0 +1,36 @@
+#ifndef CRC32_MULTI_H
+#define CRC32_MULTI_H
+
+/*
+ * Checksum many buffers at once, see vec_crc32_multi.c.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of either:
+ *
+ *  a) the GNU General Public License as published by the Free Software
+ *     Foundation; either version 2 of the License, or (at your option)
+ *     any later version, or
+ *  b) the Apache License, Version 2.0
+ */
+
+/* crc32_vpmsum_verify() flags */
+#define CRC32_VERIFY_STOP	1	/* stop at the first bad segment */
+
+#define CRC32_VERIFY_BITS	(8 * sizeof(unsigned long))
+
+/* Test bit i of a crc32_vpmsum_verify() bitmap */
+#define CRC32_VERIFY_BAD(bad, i) \
+	(((bad)[(i) / CRC32_VERIFY_BITS] >> ((i) % CRC32_VERIFY_BITS)) & 1)
+
+void crc32_vpmsum_multi(unsigned int *crcs, const unsigned char **ptrs,
+			unsigned long len, unsigned int n);
+
+unsigned long crc32_vpmsum_verify(const unsigned char *p, unsigned long len,
+				  unsigned long seg,
+				  const unsigned int *expected,
+				  unsigned long *bad, unsigned int flags);
+
+unsigned int crc32_vpmsum_segments(const unsigned char *p, unsigned long len,
+				   unsigned long seg, unsigned int *out);
+
+#endif
@@ -0,0 +1,56 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of either:
+ *
+ *  a) the GNU General Public License as published by the Free Software
+ *     Foundation; either version 2 of the License, or (at your option)
+ *     any later version, or
+ *  b) the Apache License, Version 2.0
+ */
+#include <malloc.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include <stdio.h>
+
+void crc32_vpmsum_multi(unsigned int *crcs, const unsigned char **ptrs,
+			unsigned long len, unsigned int n);
+
+int main(int argc, char *argv[])
+{
+	unsigned long length, buffers, iterations;
+	unsigned char *data;
+	const unsigned char **ptrs;
+	unsigned int *crcs, crc = 0;
+	unsigned long i;
+
+	if (argc != 4) {
+		fprintf(stderr, "Usage: %s length buffers iterations\n", argv[0]);
+		fprintf(stderr, "Performs crc32 checksum of [buffers] independent buffers of [length] bytes filled with junk data, an [iterations] number of times\n");
+		exit(1);
+	}
+
+	length = strtoul(argv[1], NULL, 0);
+	buffers = strtoul(argv[2], NULL, 0);
+	iterations = strtoul(argv[3], NULL, 0);
+
+	data = memalign(getpagesize(), length * buffers);
+	ptrs = malloc(buffers * sizeof(*ptrs));
+	crcs = calloc(buffers, sizeof(*crcs));
+
+	srandom(1);
+	for (i = 0; i < length * buffers; i++)
+		data[i] = random() & 0xff;
+
+	for (i = 0; i < buffers; i++)
+		ptrs[i] = data + i * length;
+
+	for (i = 0; i < iterations; i++)
+		crc32_vpmsum_multi(crcs, ptrs, length, buffers);
+
+	for (i = 0; i < buffers; i++)
+		crc ^= crcs[i];
+
+	printf("CRC: %08x\n", crc);
+
+	return 0;
+}
@@ -0,0 +1,102 @@
+/*
+ * Test checksumming many buffers at once against the reference model.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of either:
+ *
+ *  a) the GNU General Public License as published by the Free Software
+ *     Foundation; either version 2 of the License, or (at your option)
+ *     any later version, or
+ *  b) the Apache License, Version 2.0
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include "crcmodel.h"
+#include "crc32_constants.h"
+
+#define MAX_BUFFERS	19
+#define MAX_CRC_LENGTH	4200
+#define ITERATIONS	2000
+
+void crc32_vpmsum_multi(unsigned int *crcs, const unsigned char **ptrs,
+			unsigned long len, unsigned int n);
+
+static unsigned int verify_crc(unsigned int crc, const unsigned char *p,
+			       unsigned long len)
+{
+	cm_t cm_t = { 0, };
+	int i;
+
+	cm_t.cm_width = 32;
+	cm_t.cm_poly  = CRC;
+	cm_t.cm_init  = crc;
+#ifdef REFLECT
+	cm_t.cm_refin = TRUE;
+	cm_t.cm_refot = TRUE;
+#else
+	cm_t.cm_refin = FALSE;
+	cm_t.cm_refot = FALSE;
+#endif
+#ifdef CRC_XOR
+	cm_t.cm_init ^= 0xffffffff;
+	cm_t.cm_xorot = 0xffffffff;
+#else
+	cm_t.cm_xorot = 0x0;
+#endif
+	cm_ini(&cm_t);
+
+	for (i = 0; i < len; i++)
+		cm_nxt(&cm_t, p[i]);
+
+	return cm_crc(&cm_t);
+}
+
+int main(void)
+{
+	unsigned char *data;
+	const unsigned char *ptrs[MAX_BUFFERS];
+	unsigned int crcs[MAX_BUFFERS], initial[MAX_BUFFERS];
+	unsigned long i, size;
+	int ret = 0;
+
+	size = MAX_BUFFERS * (MAX_CRC_LENGTH + 16);
+	data = malloc(size);
+	if (!data) {
+		perror("malloc");
+		exit(1);
+	}
+
+	srandom(1);
+
+	for (i = 0; i < size; i++)
+		data[i] = random() & 0xff;
+
+	for (i = 0; i < ITERATIONS; i++) {
+		unsigned long len;
+		unsigned int j, n, verify;
+
+		/* Favour the short lengths, where the edge cases are */
+		len = random() % (i & 1 ? MAX_CRC_LENGTH : 300);
+		n = random() % (MAX_BUFFERS + 1);
+
+		for (j = 0; j < n; j++) {
+			ptrs[j] = data + j * (MAX_CRC_LENGTH + 16) + random() % 16;
+			initial[j] = crcs[j] = random();
+		}
+
+		crc32_vpmsum_multi(crcs, ptrs, len, n);
+
+		for (j = 0; j < n; j++) {
+			verify = verify_crc(initial[j], ptrs[j], len);
+			if (crcs[j] != verify) {
+				printf("FAILURE: buffer %u got 0x%08x expected 0x%08x (len %lu n %u)\n",
+				       j, crcs[j], verify, len, n);
+				ret = 1;
+			}
+		}
+	}
+
+	free(data);
+
+	return ret;
+}
@@ -0,0 +1,153 @@
+/*
+ * Calculate the CRC of a large buffer on several threads.
+ *
+ * The buffer is split into equal slices, each slice is checksummed with
+ * crc32_vpmsum() on its own thread, and the results are merged left to
+ * right with crc32_combine_op(). Every slice but the last has the same
+ * length, so the shift operator only has to be generated once (twice if
+ * the last slice is shorter). The result is bit identical to calling
+ * crc32_vpmsum() on the whole buffer.
+ *
+ * By default the slices are run on pthreads. A caller that already has a
+ * thread pool can pass its own executor instead.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of either:
+ *
+ *  a) the GNU General Public License as published by the Free Software
+ *     Foundation; either version 2 of the License, or (at your option)
+ *     any later version, or
+ *  b) the Apache License, Version 2.0
+ */
+#include <stdlib.h>
+#include <pthread.h>
+
+#ifdef CRC32_CONSTANTS_HEADER
+#include CRC32_CONSTANTS_HEADER
+#else
+#include "crc32_constants.h"
+#endif
+
+#include "crc32_parallel.h"
+
+#ifndef CRC32_FUNCTION
+#define CRC32_FUNCTION			crc32_vpmsum
+#endif
+#ifndef CRC32_PARALLEL_FUNCTION
+#define CRC32_PARALLEL_FUNCTION		crc32_vpmsum_parallel
+#endif
+#ifndef CRC32_COMBINE_GEN_FUNCTION
+#define CRC32_COMBINE_GEN_FUNCTION	crc32_combine_gen
+#endif
+#ifndef CRC32_COMBINE_OP_FUNCTION
+#define CRC32_COMBINE_OP_FUNCTION	crc32_combine_op
+#endif
+
+/*
+ * Don't bother splitting below this. Starting a thread costs more than
+ * checksumming a few hundred kB on one core.
+ */
+#ifndef CRC32_PARALLEL_MIN_SLICE
+#define CRC32_PARALLEL_MIN_SLICE	(256*1024)
+#endif
+
+/* Keep slice boundaries cacheline aligned relative to the start */
+#define SLICE_ALIGN			128
+
+unsigned int CRC32_FUNCTION(unsigned int crc, unsigned char *p,
+			    unsigned long len);
+unsigned int CRC32_COMBINE_GEN_FUNCTION(unsigned long len2);
+unsigned int CRC32_COMBINE_OP_FUNCTION(unsigned int crc1, unsigned int crc2,
+				       unsigned int op);
+
+struct crc32_slice {
+	unsigned int crc;
+	unsigned char *p;
+	unsigned long len;
+};
+
+static void crc32_slice_fn(void *arg)
+{
+	struct crc32_slice *s = arg;
+
+	s->crc = CRC32_FUNCTION(s->crc, s->p, s->len);
+}
+
+static void *crc32_thread_fn(void *arg)
+{
+	crc32_slice_fn(arg);
+	return NULL;
+}
+
+/*
+ * Default executor: one pthread per slice but the first, which runs on
+ * the calling thread. If a thread can't be created its slice is run
+ * inline, so this never fails.
+ */
+static void crc32_pthread_executor(void (*fn)(void *), void **args,
+				   unsigned int n, void *data)
+{
+	pthread_t threads[CRC32_PARALLEL_MAX_THREADS];
+	int started[CRC32_PARALLEL_MAX_THREADS];
+	unsigned int i;
+
+	for (i = 1; i < n; i++)
+		started[i] = !pthread_create(&threads[i], NULL,
+					     crc32_thread_fn, args[i]);
+
+	fn(args[0]);
+
+	for (i = 1; i < n; i++) {
+		if (started[i])
+			pthread_join(threads[i], NULL);
+		else
+			fn(args[i]);
+	}
+}
+
+unsigned int CRC32_PARALLEL_FUNCTION(unsigned int crc, unsigned char *p,
+				     unsigned long len, unsigned int nthreads,
+				     crc32_executor_t executor, void *data)
+{
+	struct crc32_slice slices[CRC32_PARALLEL_MAX_THREADS];
+	void *args[CRC32_PARALLEL_MAX_THREADS];
+	unsigned long slice_len, last_len;
+	unsigned int i, n, op;
+
+	if (nthreads > CRC32_PARALLEL_MAX_THREADS)
+		nthreads = CRC32_PARALLEL_MAX_THREADS;
+
+	n = len / CRC32_PARALLEL_MIN_SLICE;
+	if (n > nthreads)
+		n = nthreads;
+
+	if (n <= 1)
+		return CRC32_FUNCTION(crc, p, len);
+
+	slice_len = (len / n + SLICE_ALIGN - 1) & ~(SLICE_ALIGN - 1UL);
+	last_len = len - slice_len * (n - 1);
+
+	for (i = 0; i < n; i++) {
+		slices[i].crc = 0;
+		slices[i].p = p + slice_len * i;
+		slices[i].len = slice_len;
+		args[i] = &slices[i];
+	}
+	slices[0].crc = crc;
+	slices[n-1].len = last_len;
+
+	if (!executor)
+		executor = crc32_pthread_executor;
+
+	executor(crc32_slice_fn, args, n, data);
+
+	op = CRC32_COMBINE_GEN_FUNCTION(slice_len);
+	crc = slices[0].crc;
+	for (i = 1; i < n - 1; i++)
+		crc = CRC32_COMBINE_OP_FUNCTION(crc, slices[i].crc, op);
+
+	if (last_len != slice_len)
+		op = CRC32_COMBINE_GEN_FUNCTION(last_len);
+
+	return CRC32_COMBINE_OP_FUNCTION(crc, slices[n-1].crc, op);
+}
@@ -0,0 +1,34 @@
+#ifndef CRC32_PARALLEL_H
+#define CRC32_PARALLEL_H
+
+/*
+ * Checksum a large buffer on several threads, see crc32_parallel.c.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of either:
+ *
+ *  a) the GNU General Public License as published by the Free Software
+ *     Foundation; either version 2 of the License, or (at your option)
+ *     any later version, or
+ *  b) the Apache License, Version 2.0
+ */
+
+#define CRC32_PARALLEL_MAX_THREADS	64
+
+/*
+ * An executor runs fn(args[i]) for i = 0 .. n-1, in any order and on any
+ * threads, and returns once all of them have completed. data is passed
+ * through unchanged from crc32_vpmsum_parallel().
+ */
+typedef void (*crc32_executor_t)(void (*fn)(void *), void **args,
+				 unsigned int n, void *data);
+
+/*
+ * Same result as crc32_vpmsum(crc, p, len), spread across at most
+ * nthreads threads. If executor is NULL, pthreads are used.
+ */
+unsigned int crc32_vpmsum_parallel(unsigned int crc, unsigned char *p,
+				   unsigned long len, unsigned int nthreads,
+				   crc32_executor_t executor, void *data);
+
+#endif
@@ -0,0 +1,83 @@
+/*
+ * Test the multi-threaded CRC against the single threaded one.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of either:
+ *
+ *  a) the GNU General Public License as published by the Free Software
+ *     Foundation; either version 2 of the License, or (at your option)
+ *     any later version, or
+ *  b) the Apache License, Version 2.0
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include "crc32_parallel.h"
+
+#define MAX_CRC_LENGTH	(8*1024*1024)
+#define ITERATIONS	50
+
+unsigned int crc32_vpmsum(unsigned int crc, unsigned char *p,
+			  unsigned long len);
+
+/* Run the slices backwards on the calling thread */
+static void reverse_executor(void (*fn)(void *), void **args, unsigned int n,
+			     void *data)
+{
+	unsigned int *calls = data;
+
+	while (n--) {
+		fn(args[n]);
+		(*calls)++;
+	}
+}
+
+int main(void)
+{
+	unsigned char *data;
+	unsigned long i;
+	int ret = 0;
+
+	data = malloc(MAX_CRC_LENGTH);
+	if (!data) {
+		perror("malloc");
+		exit(1);
+	}
+
+	srandom(1);
+
+	for (i = 0; i < MAX_CRC_LENGTH; i++)
+		data[i] = random() & 0xff;
+
+	for (i = 0; i < ITERATIONS; i++) {
+		unsigned long len, offset;
+		unsigned int initial, nthreads, calls = 0;
+		unsigned int crc, verify;
+
+		offset = random() % 16;
+		len = random() % (MAX_CRC_LENGTH - offset);
+		initial = random();
+		nthreads = 1 + random() % 16;
+
+		verify = crc32_vpmsum(initial, data + offset, len);
+
+		crc = crc32_vpmsum_parallel(initial, data + offset, len,
+					    nthreads, NULL, NULL);
+		if (crc != verify) {
+			printf("FAILURE: got 0x%08x expected 0x%08x (len %lu offset %lu threads %u)\n",
+			       crc, verify, len, offset, nthreads);
+			ret = 1;
+		}
+
+		crc = crc32_vpmsum_parallel(initial, data + offset, len,
+					    nthreads, reverse_executor, &calls);
+		if (crc != verify) {
+			printf("FAILURE: executor got 0x%08x expected 0x%08x (len %lu offset %lu threads %u calls %u)\n",
+			       crc, verify, len, offset, nthreads, calls);
+			ret = 1;
+		}
+	}
+
+	free(data);
+
+	return ret;
+}
@@ -0,0 +1,276 @@
+#ifndef CRC32_REDUCE_H
+#define CRC32_REDUCE_H
+
+/*
+ * The start and end of the fixed distance fold in vec_crc32_fold.c: line
+ * up the initial value with the data, and at the end fold 8 streams into
+ * one, reduce the final 128 bits to 64 bits and Barrett reduce that to
+ * the 32 bit CRC.
+ *
+ * Between the two reductions the checksum is a 64 bit sum of products:
+ * the vpmsumw result, whose two doublewords xored together Barrett reduce
+ * to the CRC so far. crc32_shift() moves it past up to 15 more bytes with
+ * one vpmsumw by vcrc_shift_const (POWER8_SHIFT_INTRINSICS), so a partial
+ * chunk can be added to it in registers, and crc32_sum_vcrc() turns it
+ * into the initial value for the data that follows.
+ *
+ * The constants are passed in, in the vcrc_fold_const and v_Barrett_const
+ * layout, so other kernels built on these constants can share the code.
+ * reflect picks the bit order. Pass CRC32_REFLECTED, a constant, so only
+ * one branch is compiled.
+ *
+ * Include after altivec.h and the __builtin_pack_vector() and
+ * __builtin_unpack_vector_0/1() definitions.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of either:
+ *
+ *  a) the GNU General Public License as published by the Free Software
+ *     Foundation; either version 2 of the License, or (at your option)
+ *     any later version, or
+ *  b) the Apache License, Version 2.0
+ */
+
+#ifdef REFLECT
+#define CRC32_REFLECTED	1
+#else
+#define CRC32_REFLECTED	0
+#endif
+
+/* The initial value, lined up with the first 16 bytes of data. */
+static inline __vector unsigned long long crc32_init_vcrc(unsigned int crc,
+							  int reflect)
+{
+	const __vector unsigned long long vzero = {0,0};
+	__vector unsigned long long vcrc;
+
+	if (reflect)
+		return (__vector unsigned long long)__builtin_pack_vector(0UL, crc);
+
+	vcrc = (__vector unsigned long long)__builtin_pack_vector(crc, 0UL);
+
+	/* Shift into top 32 bits */
+	return (__vector unsigned long long)vec_sld((__vector unsigned char)vcrc,
+		(__vector unsigned char)vzero, 4);
+}
+
+/* Fold the 8 streams in v into one: by 512, then 256, then 128 bits. */
+static inline __vector unsigned long long
+crc32_fold_streams(__vector unsigned long long *v,
+		   const __vector unsigned long long *fold_const)
+{
+	const __vector unsigned long long vfold512 = vec_ld(16, fold_const);
+	const __vector unsigned long long vfold256 = vec_ld(32, fold_const);
+	const __vector unsigned long long vfold128 = vec_ld(48, fold_const);
+
+	__vector unsigned long long va0, va1, va2, va3;
+
+	va0 = __builtin_crypto_vpmsumd(v[0], vfold512);
+	va1 = __builtin_crypto_vpmsumd(v[1], vfold512);
+	va2 = __builtin_crypto_vpmsumd(v[2], vfold512);
+	va3 = __builtin_crypto_vpmsumd(v[3], vfold512);
+
+	v[0] = vec_xor(v[4], va0);
+	v[1] = vec_xor(v[5], va1);
+	v[2] = vec_xor(v[6], va2);
+	v[3] = vec_xor(v[7], va3);
+
+	va0 = __builtin_crypto_vpmsumd(v[0], vfold256);
+	va1 = __builtin_crypto_vpmsumd(v[1], vfold256);
+
+	v[0] = vec_xor(v[2], va0);
+	v[1] = vec_xor(v[3], va1);
+
+	va0 = __builtin_crypto_vpmsumd(v[0], vfold128);
+
+	return vec_xor(v[1], va0);
+}
+
+/*
+ * Barrett reduce a(x), at most 64 bits in the low doubleword of v0, to
+ * a(x) mod p(x). A reflected a(x) is one bit short and is shifted up
+ * first. The high doubleword is ignored.
+ *
+ * http://en.wikipedia.org/wiki/Barrett_reduction
+ */
+static inline unsigned int
+crc32_barrett(__vector unsigned long long v0,
+	      const __vector unsigned long long *barrett_const, int reflect)
+{
+	const __vector unsigned long long vzero = {0,0};
+	const __vector unsigned long long vones = {0xffffffffffffffffUL,
+		0xffffffffffffffffUL};
+
+	const __vector unsigned long long vmask_32bit =
+		(__vector unsigned long long)vec_sld((__vector unsigned char)vzero,
+			(__vector unsigned char)vones, 4);
+
+	const __vector unsigned long long vmask_64bit =
+		(__vector unsigned long long)vec_sld((__vector unsigned char)vzero,
+			(__vector unsigned char)vones, 8);
+
+	const __vector unsigned long long vconst1 = vec_ld(0, barrett_const);
+	const __vector unsigned long long vconst2 = vec_ld(16, barrett_const);
+
+	__vector unsigned long long v1;
+
+	if (!reflect) {
+		v0 = vec_and(v0, vmask_64bit);
+
+		/*
+		 * Now for the actual algorithm. The idea is to calculate q,
+		 * the multiple of our polynomial that we need to subtract. By
+		 * doing the computation 2x bits higher (ie 64 bits) and
+		 * shifting the result back down 2x bits, we round down to the
+		 * nearest multiple.
+		 */
+
+		/* ma */
+		v1 = __builtin_crypto_vpmsumd(v0, vconst1);
+		/* q = floor(ma/(2^64)) */
+		v1 = (__vector unsigned long long)vec_sld((__vector unsigned char)vzero,
+				(__vector unsigned char)v1, 8);
+		/* qn */
+		v1 = __builtin_crypto_vpmsumd(v1, vconst2);
+		/* a - qn, subtraction is xor in GF(2) */
+		v0 = vec_xor(v0, v1);
+
+		/*
+		 * Get the result into r3. We need to shift it left 8 bytes:
+		 * V0 [ 0 1 2 X ]
+		 * V0 [ 0 X 2 3 ]
+		 */
+		return __builtin_unpack_vector_1(v0);
+	}
+
+	/*
+	 * The reflected version of Barrett reduction. Instead of bit
+	 * reflecting our data (which is expensive to do), we bit reflect our
+	 * constants and our algorithm, which means the intermediate data in
+	 * our vector registers goes from 0-63 instead of 63-0. We can reflect
+	 * the algorithm because we don't carry in mod 2 arithmetic.
+	 */
+
+	/* shift left one bit */
+	v0 = (__vector unsigned long long)vec_sll((__vector unsigned char)v0,
+			vec_splat_u8(1));
+
+	v0 = vec_and(v0, vmask_64bit);
+
+	/* bottom 32 bits of a */
+	v1 = vec_and(v0, vmask_32bit);
+
+	/* ma */
+	v1 = __builtin_crypto_vpmsumd(v1, vconst1);
+
+	/* bottom 32bits of ma */
+	v1 = vec_and(v1, vmask_32bit);
+	/* qn */
+	v1 = __builtin_crypto_vpmsumd(v1, vconst2);
+	/* a - qn, subtraction is xor in GF(2) */
+	v0 = vec_xor(v0, v1);
+
+	/*
+	 * Since we are bit reflected, the result (ie the low 32 bits) is in
+	 * the high 32 bits. We just need to shift it left 4 bytes
+	 * V0 [ 0 1 X 3 ]
+	 * V0 [ 0 X 2 3 ]
+	 */
+
+	/* shift result into top 64 bits of */
+	v0 = (__vector unsigned long long)vec_sld((__vector unsigned char)v0,
+		(__vector unsigned char)vzero, 4);
+
+	return __builtin_unpack_vector_0(v0);
+}
+
+/* The initial value as a sum of products, for crc32_shift(). */
+static inline __vector unsigned long long crc32_init_sum(unsigned int crc,
+							 int reflect)
+{
+	if (reflect)
+		return (__vector unsigned long long)__builtin_pack_vector(0UL,
+			(unsigned long)crc << 31);
+
+	return (__vector unsigned long long)__builtin_pack_vector(0UL, crc);
+}
+
+/*
+ * Multiply v, a 64 bit sum of products waiting for Barrett reduction, by
+ * x^8len, 0 <= len < 16. Each word of v is multiplied by a constant from
+ * shift_const, so the result is another sum of products.
+ */
+static inline __vector unsigned long long
+crc32_shift(__vector unsigned long long v, unsigned long len,
+	    const __vector unsigned long long *shift_const, int reflect)
+{
+	v = vec_xor(v, (__vector unsigned long long)vec_sld(
+		(__vector unsigned char)v, (__vector unsigned char)v, 8));
+
+	/* shift left one bit */
+	if (reflect)
+		v = (__vector unsigned long long)vec_sll(
+			(__vector unsigned char)v, vec_splat_u8(1));
+
+	return (__vector unsigned long long)__builtin_crypto_vpmsumw(
+		(__vector unsigned int)v,
+		(__vector unsigned int)vec_ld(len * 16, shift_const));
+}
+
+/*
+ * The initial value for data that follows the sum of products v. It is
+ * xored into the top 32 bits of the first chunk, so shift v by 96 bits
+ * and line it up with the data.
+ */
+static inline __vector unsigned long long
+crc32_sum_vcrc(__vector unsigned long long v,
+	       const __vector unsigned long long *shift_const, int reflect)
+{
+	const __vector unsigned long long vzero = {0,0};
+
+	v = crc32_shift(v, 12, shift_const, reflect);
+	if (reflect) {
+		v = (__vector unsigned long long)vec_sll(
+			(__vector unsigned char)v, vec_splat_u8(1));
+		v = (__vector unsigned long long)vec_sld(
+			(__vector unsigned char)v, (__vector unsigned char)vzero, 8);
+	}
+
+	return v;
+}
+
+/*
+ * Reduce the final 128 bits to a 64 bit sum of products, shifting 32 bits
+ * to include the trailing 32 bits of zeros.
+ */
+static inline __vector unsigned long long
+crc32_sum(__vector unsigned long long vdata0,
+	  const __vector unsigned long long *fold_const)
+{
+	return (__vector unsigned long long)__builtin_crypto_vpmsumw(
+		(__vector unsigned int)vdata0,
+		(__vector unsigned int)vec_ld(64, fold_const));
+}
+
+/* Barrett reduce the sum of products v to the 32 bit CRC. */
+static inline unsigned int
+crc32_sum_barrett(__vector unsigned long long v,
+		  const __vector unsigned long long *barrett_const, int reflect)
+{
+	v = vec_xor(v, (__vector unsigned long long)vec_sld(
+		(__vector unsigned char)v, (__vector unsigned char)v, 8));
+
+	return crc32_barrett(v, barrett_const, reflect);
+}
+
+/* Reduce the final 128 bits to the 32 bit CRC. */
+static inline unsigned int
+crc32_reduce(__vector unsigned long long vdata0,
+	     const __vector unsigned long long *fold_const,
+	     const __vector unsigned long long *barrett_const, int reflect)
+{
+	return crc32_sum_barrett(crc32_sum(vdata0, fold_const), barrett_const,
+				 reflect);
+}
+
+#endif
@@ -0,0 +1,96 @@
+/*
+ * Calculate the CRC of every seg byte segment of a buffer, and the CRC
+ * of the whole buffer, in one pass over the data.
+ *
+ * The segments are checksummed 4 at a time with crc32_vpmsum_multi().
+ * The CRC of the whole buffer is then chained from the segment CRCs
+ * already in out[]: crc32_combine_gen(seg) gives the operator for a full
+ * segment, and crc32_combine_op() folds out[1], out[2] ... into the
+ * running CRC with one vpmsum and Barrett reduction each. A short last
+ * segment needs its own operator. The data isn't touched again.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of either:
+ *
+ *  a) the GNU General Public License as published by the Free Software
+ *     Foundation; either version 2 of the License, or (at your option)
+ *     any later version, or
+ *  b) the Apache License, Version 2.0
+ */
+#include "crc32_multi.h"
+
+#ifndef CRC32_MULTI_FUNCTION
+#define CRC32_MULTI_FUNCTION		crc32_vpmsum_multi
+#endif
+#ifndef CRC32_SEGMENTS_FUNCTION
+#define CRC32_SEGMENTS_FUNCTION		crc32_vpmsum_segments
+#endif
+#ifndef CRC32_COMBINE_GEN_FUNCTION
+#define CRC32_COMBINE_GEN_FUNCTION	crc32_combine_gen
+#endif
+#ifndef CRC32_COMBINE_OP_FUNCTION
+#define CRC32_COMBINE_OP_FUNCTION	crc32_combine_op
+#endif
+
+/* Segments checksummed per crc32_vpmsum_multi() call */
+#define SEGMENT_WAYS			4
+
+void CRC32_MULTI_FUNCTION(unsigned int *crcs, const unsigned char **ptrs,
+			  unsigned long len, unsigned int n);
+unsigned int CRC32_COMBINE_GEN_FUNCTION(unsigned long len2);
+unsigned int CRC32_COMBINE_OP_FUNCTION(unsigned int crc1, unsigned int crc2,
+				       unsigned int op);
+
+/*
+ * Fill out[] with the CRC (initial value 0) of each seg byte segment of
+ * p, including a shorter last segment, and return the CRC of all len
+ * bytes, the same as crc32_vpmsum(0, p, len).
+ */
+unsigned int CRC32_SEGMENTS_FUNCTION(const unsigned char *p,
+				     unsigned long len, unsigned long seg,
+				     unsigned int *out)
+{
+	const unsigned char *ptrs[SEGMENT_WAYS];
+	unsigned long nfull, tail, i;
+	unsigned int crc, op;
+	unsigned int j, ways;
+
+	if (!seg || !len)
+		return 0;
+
+	nfull = len / seg;
+	tail = len % seg;
+
+	for (i = 0; i < nfull; i += ways) {
+		ways = nfull - i;
+		if (ways > SEGMENT_WAYS)
+			ways = SEGMENT_WAYS;
+
+		for (j = 0; j < ways; j++) {
+			ptrs[j] = p + (i + j) * seg;
+			out[i + j] = 0;
+		}
+
+		CRC32_MULTI_FUNCTION(out + i, ptrs, seg, ways);
+	}
+
+	if (tail) {
+		ptrs[0] = p + nfull * seg;
+		out[nfull] = 0;
+		CRC32_MULTI_FUNCTION(out + nfull, ptrs, tail, 1);
+	}
+
+	crc = out[0];
+
+	if (nfull > 1) {
+		op = CRC32_COMBINE_GEN_FUNCTION(seg);
+		for (i = 1; i < nfull; i++)
+			crc = CRC32_COMBINE_OP_FUNCTION(crc, out[i], op);
+	}
+
+	if (tail && nfull)
+		crc = CRC32_COMBINE_OP_FUNCTION(crc, out[nfull],
+					CRC32_COMBINE_GEN_FUNCTION(tail));
+
+	return crc;
+}
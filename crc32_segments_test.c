@@ -0,0 +1,112 @@
+/*
+ * Test per segment and whole buffer CRCs against the reference model.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of either:
+ *
+ *  a) the GNU General Public License as published by the Free Software
+ *     Foundation; either version 2 of the License, or (at your option)
+ *     any later version, or
+ *  b) the Apache License, Version 2.0
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include "crcmodel.h"
+#include "crc32_constants.h"
+#include "crc32_multi.h"
+
+#define MAX_SEGMENTS	70
+#define MAX_SEG_LENGTH	600
+#define ITERATIONS	2000
+
+static unsigned int verify_crc(unsigned int crc, const unsigned char *p,
+			       unsigned long len)
+{
+	cm_t cm_t = { 0, };
+	int i;
+
+	cm_t.cm_width = 32;
+	cm_t.cm_poly  = CRC;
+	cm_t.cm_init  = crc;
+#ifdef REFLECT
+	cm_t.cm_refin = TRUE;
+	cm_t.cm_refot = TRUE;
+#else
+	cm_t.cm_refin = FALSE;
+	cm_t.cm_refot = FALSE;
+#endif
+#ifdef CRC_XOR
+	cm_t.cm_init ^= 0xffffffff;
+	cm_t.cm_xorot = 0xffffffff;
+#else
+	cm_t.cm_xorot = 0x0;
+#endif
+	cm_ini(&cm_t);
+
+	for (i = 0; i < len; i++)
+		cm_nxt(&cm_t, p[i]);
+
+	return cm_crc(&cm_t);
+}
+
+int main(void)
+{
+	unsigned char *data;
+	unsigned int out[MAX_SEGMENTS + 1];
+	unsigned long i, size;
+	int ret = 0;
+
+	size = MAX_SEGMENTS * MAX_SEG_LENGTH + 16;
+	data = malloc(size);
+	if (!data) {
+		perror("malloc");
+		exit(1);
+	}
+
+	srandom(1);
+
+	for (i = 0; i < size; i++)
+		data[i] = random() & 0xff;
+
+	for (i = 0; i < ITERATIONS; i++) {
+		const unsigned char *p = data + random() % 16;
+		unsigned long seg, len, nseg, n, k;
+		unsigned int crc, verify;
+
+		seg = 1 + random() % MAX_SEG_LENGTH;
+		len = random() % (seg * MAX_SEGMENTS + 1);
+		nseg = (len + seg - 1) / seg;
+
+		/* Catch writes past the last segment */
+		out[nseg] = 0x5a5a5a5a;
+
+		crc = crc32_vpmsum_segments(p, len, seg, out);
+
+		verify = verify_crc(0, p, len);
+		if (crc != verify) {
+			printf("FAILURE: got 0x%08x expected 0x%08x (len %lu seg %lu)\n",
+			       crc, verify, len, seg);
+			ret = 1;
+		}
+
+		if (out[nseg] != 0x5a5a5a5a) {
+			printf("FAILURE: wrote past %lu segments (len %lu seg %lu)\n",
+			       nseg, len, seg);
+			ret = 1;
+		}
+
+		for (k = 0; k < nseg; k++) {
+			n = len - k * seg < seg ? len - k * seg : seg;
+			verify = verify_crc(0, p + k * seg, n);
+			if (out[k] != verify) {
+				printf("FAILURE: segment %lu got 0x%08x expected 0x%08x (len %lu seg %lu)\n",
+				       k, out[k], verify, len, seg);
+				ret = 1;
+			}
+		}
+	}
+
+	free(data);
+
+	return ret;
+}
@@ -0,0 +1,61 @@
+/*
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of either:
+ *
+ *  a) the GNU General Public License as published by the Free Software
+ *     Foundation; either version 2 of the License, or (at your option)
+ *     any later version, or
+ *  b) the Apache License, Version 2.0
+ */
+#include <malloc.h>
+#include <unistd.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <time.h>
+
+unsigned int crc32_vpmsum(unsigned int crc, unsigned char *p,
+			  unsigned long len);
+
+int main(int argc, char *argv[])
+{
+	unsigned long min, max, iterations;
+	unsigned long length, i;
+	struct timespec start, end;
+	unsigned char *data;
+	unsigned int crc = 0;
+	double ns;
+
+	if (argc != 4) {
+		fprintf(stderr, "Usage: %s min_length max_length iterations\n", argv[0]);
+		fprintf(stderr, "Performs crc32 checksum of [min_length] to [max_length] bytes of junk data, an [iterations] number of times each, and prints the ns per call for each length\n");
+		exit(1);
+	}
+
+	min = strtoul(argv[1], NULL, 0);
+	max = strtoul(argv[2], NULL, 0);
+	iterations = strtoul(argv[3], NULL, 0);
+
+	data = memalign(getpagesize(), max);
+
+	srandom(1);
+	for (i = 0; i < max; i++)
+		data[i] = random() & 0xff;
+
+	for (length = min; length <= max; length++) {
+		clock_gettime(CLOCK_MONOTONIC, &start);
+
+		/* Each call takes the previous CRC, so we measure latency */
+		for (i = 0; i < iterations; i++)
+			crc = crc32_vpmsum(crc, data, length);
+
+		clock_gettime(CLOCK_MONOTONIC, &end);
+
+		ns = (end.tv_sec - start.tv_sec) * 1e9 +
+			(end.tv_nsec - start.tv_nsec);
+		printf("%lu %.2f\n", length, ns / iterations);
+	}
+
+	printf("CRC: %08x\n", crc);
+
+	return 0;
+}
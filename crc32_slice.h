@@ -0,0 +1,107 @@
+#ifndef CRC32_SLICE_H
+#define CRC32_SLICE_H
+
+/*
+ * Table driven CRC for the bytes that don't fill a vector, and for
+ * builds without vpmsum. Instead of one dependent table lookup per
+ * byte, 8 (or 16) bytes are looked up in separate tables at once and
+ * the results xored together.
+ *
+ * Define CRC_SLICE_TABLE to 8 or 16 before including the constants
+ * header and then this one to get crc32_align(), which uses the
+ * generated crc_slice_table. crc32_slice() takes the tables and the bit
+ * order as arguments, for code with more than one polynomial. Words are
+ * assembled a byte at a time, so this works for either endian and any
+ * alignment; the compiler turns the shifts and ors into a single
+ * (possibly byte reversed) load.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of either:
+ *
+ *  a) the GNU General Public License as published by the Free Software
+ *     Foundation; either version 2 of the License, or (at your option)
+ *     any later version, or
+ *  b) the Apache License, Version 2.0
+ */
+
+#define CRC32_SLICE_INLINE	static inline __attribute__((always_inline))
+
+/* The first 4 bytes at p, in the order they enter the CRC */
+CRC32_SLICE_INLINE unsigned int
+crc32_slice_word(const unsigned char *p, int reflect)
+{
+	if (reflect)
+		return (unsigned int)p[0] | (unsigned int)p[1] << 8 |
+			(unsigned int)p[2] << 16 | (unsigned int)p[3] << 24;
+	else
+		return (unsigned int)p[0] << 24 | (unsigned int)p[1] << 16 |
+			(unsigned int)p[2] << 8 | (unsigned int)p[3];
+}
+
+/* Look up the 4 bytes of q in tables k to k - 3 */
+CRC32_SLICE_INLINE unsigned int
+crc32_slice_lookup(const unsigned int (*t)[256], unsigned int q,
+		   unsigned int k, int reflect)
+{
+	if (reflect)
+		return t[k][q & 0xff] ^ t[k - 1][(q >> 8) & 0xff] ^
+			t[k - 2][(q >> 16) & 0xff] ^ t[k - 3][q >> 24];
+	else
+		return t[k][q >> 24] ^ t[k - 1][(q >> 16) & 0xff] ^
+			t[k - 2][(q >> 8) & 0xff] ^ t[k - 3][q & 0xff];
+}
+
+/*
+ * CRC len bytes at p with slices (8 or 16) tables t. slices and reflect
+ * are expected to be constants, so only one set of loops is compiled in.
+ */
+CRC32_SLICE_INLINE unsigned int
+crc32_slice(unsigned int crc, const unsigned char *p, unsigned long len,
+	    const unsigned int (*t)[256], unsigned int slices, int reflect)
+{
+	unsigned int q;
+
+	if (slices > 8) {
+		while (len >= 16) {
+			q = crc ^ crc32_slice_word(p, reflect);
+			crc = crc32_slice_lookup(t, q, 15, reflect) ^
+			      t[11][p[4]] ^ t[10][p[5]] ^ t[9][p[6]] ^ t[8][p[7]] ^
+			      t[7][p[8]] ^ t[6][p[9]] ^ t[5][p[10]] ^ t[4][p[11]] ^
+			      t[3][p[12]] ^ t[2][p[13]] ^ t[1][p[14]] ^ t[0][p[15]];
+			p += 16;
+			len -= 16;
+		}
+	}
+
+	while (len >= 8) {
+		q = crc ^ crc32_slice_word(p, reflect);
+		crc = crc32_slice_lookup(t, q, 7, reflect) ^
+		      t[3][p[4]] ^ t[2][p[5]] ^ t[1][p[6]] ^ t[0][p[7]];
+		p += 8;
+		len -= 8;
+	}
+
+	while (len--) {
+		if (reflect)
+			crc = t[0][(crc ^ *p++) & 0xff] ^ (crc >> 8);
+		else
+			crc = t[0][((crc >> 24) ^ *p++) & 0xff] ^ (crc << 8);
+	}
+
+	return crc;
+}
+
+#ifdef CRC_SLICE_TABLE
+static inline unsigned int crc32_align(unsigned int crc,
+				       const unsigned char *p,
+				       unsigned long len)
+{
+#ifdef REFLECT
+	return crc32_slice(crc, p, len, crc_slice_table, CRC_SLICE_TABLE, 1);
+#else
+	return crc32_slice(crc, p, len, crc_slice_table, CRC_SLICE_TABLE, 0);
+#endif
+}
+#endif
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef CRC32_STREAM_H
+#define CRC32_STREAM_H
+
+/*
+ * Incremental and iovec interfaces to the vpmsum CRC, see
+ * vec_crc32_stream.c.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of either:
+ *
+ *  a) the GNU General Public License as published by the Free Software
+ *     Foundation; either version 2 of the License, or (at your option)
+ *     any later version, or
+ *  b) the Apache License, Version 2.0
+ */
+
+#include <sys/uio.h>
+
+/*
+ * Running checksum for crc32_stream_*(). The contents are private: the
+ * 1024 bit fold state of the current run of 16 byte chunks, the number
+ * of chunks in it, and everything before the run as a 64 bit sum of
+ * products.
+ */
+struct crc32_stream {
+	unsigned long long acc[16] __attribute__ ((aligned (16)));
+	unsigned long long sum[2] __attribute__ ((aligned (16)));
+	unsigned long chunks;
+};
+
+void crc32_stream_init(struct crc32_stream *s, unsigned int crc);
+void crc32_stream_update(struct crc32_stream *s, const unsigned char *p,
+			 unsigned long len);
+void crc32_stream_copy(struct crc32_stream *s, unsigned char *dst,
+		       const unsigned char *src, unsigned long len);
+unsigned int crc32_stream_final(struct crc32_stream *s);
+
+unsigned int crc32_vpmsum_copy(unsigned int crc, unsigned char *dst,
+			       const unsigned char *src, unsigned long len);
+unsigned int crc32_vpmsum_iov(unsigned int crc, const struct iovec *iov,
+			      int iovcnt);
+
+#endif
@@ -0,0 +1,152 @@
+/*
+ * Test the streaming, iovec and copy interfaces against the reference
+ * model.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of either:
+ *
+ *  a) the GNU General Public License as published by the Free Software
+ *     Foundation; either version 2 of the License, or (at your option)
+ *     any later version, or
+ *  b) the Apache License, Version 2.0
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "crcmodel.h"
+#include "crc32_constants.h"
+#include "crc32_stream.h"
+
+#define MAX_SEGMENTS	32
+#define MAX_CRC_LENGTH	(64*1024)
+#define ITERATIONS	2000
+
+static unsigned int verify_crc(unsigned int crc, const unsigned char *p,
+			       unsigned long len)
+{
+	cm_t cm_t = { 0, };
+	int i;
+
+	cm_t.cm_width = 32;
+	cm_t.cm_poly  = CRC;
+	cm_t.cm_init  = crc;
+#ifdef REFLECT
+	cm_t.cm_refin = TRUE;
+	cm_t.cm_refot = TRUE;
+#else
+	cm_t.cm_refin = FALSE;
+	cm_t.cm_refot = FALSE;
+#endif
+#ifdef CRC_XOR
+	cm_t.cm_init ^= 0xffffffff;
+	cm_t.cm_xorot = 0xffffffff;
+#else
+	cm_t.cm_xorot = 0x0;
+#endif
+	cm_ini(&cm_t);
+
+	for (i = 0; i < len; i++)
+		cm_nxt(&cm_t, p[i]);
+
+	return cm_crc(&cm_t);
+}
+
+int main(void)
+{
+	unsigned char *data, *copy;
+	struct iovec iov[MAX_SEGMENTS];
+	struct crc32_stream s;
+	unsigned long i;
+	int ret = 0;
+
+	data = malloc(MAX_CRC_LENGTH);
+	copy = malloc(MAX_CRC_LENGTH + 16);
+	if (!data || !copy) {
+		perror("malloc");
+		exit(1);
+	}
+
+	srandom(1);
+
+	for (i = 0; i < MAX_CRC_LENGTH; i++)
+		data[i] = random() & 0xff;
+
+	for (i = 0; i < ITERATIONS; i++) {
+		unsigned long len, offset, dst_offset, pos;
+		unsigned int initial, crc, verify;
+		int j, n;
+
+		offset = random() % 16;
+		/* Mostly short segments, where the seams are */
+		len = random() % (i & 1 ? MAX_CRC_LENGTH - offset : 1024);
+		n = 1 + random() % MAX_SEGMENTS;
+		initial = random();
+		dst_offset = random() % 16;
+
+		/* Split [offset, offset + len) into n consecutive segments */
+		pos = offset;
+		for (j = 0; j < n; j++) {
+			unsigned long left = offset + len - pos;
+			unsigned long seg = left;
+
+			if (j < n - 1 && left) {
+				seg = random() % (left + 1);
+				if (!(random() % 4) && seg > 64)
+					seg = random() % 64;
+			}
+
+			iov[j].iov_base = data + pos;
+			iov[j].iov_len = seg;
+			pos += seg;
+		}
+
+		verify = verify_crc(initial, data + offset, len);
+
+		crc = crc32_vpmsum_iov(initial, iov, n);
+		if (crc != verify) {
+			printf("FAILURE: crc32_vpmsum_iov got 0x%08x expected 0x%08x (len %lu offset %lu segments %d)\n",
+			       crc, verify, len, offset, n);
+			ret = 1;
+		}
+
+		crc32_stream_init(&s, initial);
+		for (j = 0; j < n; j++)
+			crc32_stream_update(&s, iov[j].iov_base, iov[j].iov_len);
+		crc = crc32_stream_final(&s);
+		if (crc != verify) {
+			printf("FAILURE: crc32_stream_update got 0x%08x expected 0x%08x (len %lu offset %lu segments %d)\n",
+			       crc, verify, len, offset, n);
+			ret = 1;
+		}
+
+		memset(copy, 0, MAX_CRC_LENGTH + 16);
+		crc32_stream_init(&s, initial);
+		for (j = 0, pos = dst_offset; j < n; j++) {
+			crc32_stream_copy(&s, copy + pos, iov[j].iov_base,
+					  iov[j].iov_len);
+			pos += iov[j].iov_len;
+		}
+		crc = crc32_stream_final(&s);
+		if (crc != verify ||
+		    memcmp(copy + dst_offset, data + offset, len)) {
+			printf("FAILURE: crc32_stream_copy got 0x%08x expected 0x%08x (len %lu offset %lu segments %d)\n",
+			       crc, verify, len, offset, n);
+			ret = 1;
+		}
+
+		memset(copy, 0, MAX_CRC_LENGTH + 16);
+		crc = crc32_vpmsum_copy(initial, copy + dst_offset,
+					data + offset, len);
+		if (crc != verify ||
+		    memcmp(copy + dst_offset, data + offset, len)) {
+			printf("FAILURE: crc32_vpmsum_copy got 0x%08x expected 0x%08x (len %lu offset %lu)\n",
+			       crc, verify, len, offset);
+			ret = 1;
+		}
+	}
+
+	free(copy);
+	free(data);
+
+	return ret;
+}
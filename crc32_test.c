@@ -26,6 +26,10 @@ unsigned int crc32_vpmsum(unsigned int crc, unsigned char *p,
 unsigned int crc32_vpmsum_c(unsigned int crc, unsigned char *p,
 			  unsigned long len);
 
+/* C fixed distance folding implementation */
+unsigned int crc32_vpmsum_fold(unsigned int crc, unsigned char *p,
+			  unsigned long len);
+
 static unsigned int verify_crc(unsigned int crc, unsigned char *p,
 			       unsigned long len)
 {
@@ -68,7 +72,7 @@ int main(int argc, char *argv[])
 	unsigned long i;
 	unsigned int initial_value;
 	unsigned char *data, *data_initial;
-	unsigned int crc, crc_c, verify, seed;
+	unsigned int crc, crc_c, crc_fold, verify, seed;
 	int j, ret = 0;
 
 	if (argc < 3 || argc > 4) {
@@ -103,6 +107,7 @@ int main(int argc, char *argv[])
 
 	crc = crc32_vpmsum(initial_value, data, length);
 	crc_c = crc32_vpmsum_c(initial_value, data, length);
+	crc_fold = crc32_vpmsum_fold(initial_value, data, length);
 	verify = verify_crc(initial_value, data, length);
 
 	if (crc_c != verify) {
@@ -110,6 +115,11 @@ int main(int argc, char *argv[])
 		ret = 1;
 	}
 
+	if (crc_fold != verify) {
+		printf("FAILURE: C crc32_vpmsum_fold got 0x%08x expected 0x%08x\n", crc_fold, verify);
+		ret = 1;
+	}
+
 	if (crc != verify) {
 		printf("FAILURE: ASM crc32_vpmsum got 0x%08x expected 0x%08x\n", crc, verify);
 		ret = 1;
@@ -123,11 +133,17 @@ int main(int argc, char *argv[])
 
 		crc = crc32_vpmsum(initial_value, data, length);
 		crc_c = crc32_vpmsum_c(initial_value, data, length);
+		crc_fold = crc32_vpmsum_fold(initial_value, data, length);
 		if (crc_c != verify) {
 			printf("FAILURE: C crc32_vpmsum, at alignment offset %d, got 0x%08x expected 0x%08x\n", j, crc_c, verify);
 			ret = 1;
 		}
 
+		if (crc_fold != verify) {
+			printf("FAILURE: C crc32_vpmsum_fold, at alignment offset %d, got 0x%08x expected 0x%08x\n", j, crc_fold, verify);
+			ret = 1;
+		}
+
 		if (crc != verify) {
 			printf("FAILURE: ASM crc32_vpmsum, at alignment offset %d, got 0x%08x expected 0x%08x\n", j, crc, verify);
 			ret = 1;
@@ -0,0 +1,69 @@
+/*
+ * Update the CRC of a buffer after n bytes at offset have been
+ * overwritten, without reading the rest of the buffer.
+ *
+ * Ignoring the initial value and CRC_XOR, which cancel out, a CRC is
+ * linear in the data. The old and new buffers differ by
+ * delta = old_bytes xor new_bytes at offset, and zeros everywhere else,
+ * so:
+ *
+ *	CRC(new) = CRC(old) xor CRC(delta . 0^m)
+ *		 = CRC(old) xor (CRC(delta) . (x^(8*m) mod p(x)))
+ *
+ * where m = total_len - offset - n is the distance from the end of the
+ * change to the end of the buffer. Zeros before the change don't affect
+ * CRC(delta). CRC(delta) is CRC(old_bytes) xor CRC(new_bytes) with any
+ * matching initial value, so no temporary buffer is needed, and the shift
+ * is crc32_combine_op(). The cost is two passes over n bytes plus
+ * O(log m) multiplies, whatever the size of the buffer.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of either:
+ *
+ *  a) the GNU General Public License as published by the Free Software
+ *     Foundation; either version 2 of the License, or (at your option)
+ *     any later version, or
+ *  b) the Apache License, Version 2.0
+ */
+#ifndef CRC32_FUNCTION
+#define CRC32_FUNCTION			crc32_vpmsum
+#endif
+#ifndef CRC32_UPDATE_FUNCTION
+#define CRC32_UPDATE_FUNCTION		crc32_vpmsum_update
+#endif
+#ifndef CRC32_COMBINE_GEN_FUNCTION
+#define CRC32_COMBINE_GEN_FUNCTION	crc32_combine_gen
+#endif
+#ifndef CRC32_COMBINE_OP_FUNCTION
+#define CRC32_COMBINE_OP_FUNCTION	crc32_combine_op
+#endif
+
+unsigned int CRC32_FUNCTION(unsigned int crc, unsigned char *p,
+			    unsigned long len);
+unsigned int CRC32_COMBINE_GEN_FUNCTION(unsigned long len2);
+unsigned int CRC32_COMBINE_OP_FUNCTION(unsigned int crc1, unsigned int crc2,
+				       unsigned int op);
+
+/*
+ * Return the CRC of a total_len byte buffer whose CRC was old_crc, after
+ * the n bytes at offset change from old_bytes to new_bytes. offset + n
+ * must not exceed total_len.
+ */
+unsigned int CRC32_UPDATE_FUNCTION(unsigned int old_crc,
+				   unsigned long total_len,
+				   unsigned long offset,
+				   const unsigned char *old_bytes,
+				   const unsigned char *new_bytes,
+				   unsigned long n)
+{
+	unsigned int delta;
+
+	if (!n)
+		return old_crc;
+
+	delta = CRC32_FUNCTION(0, (unsigned char *)old_bytes, n) ^
+		CRC32_FUNCTION(0, (unsigned char *)new_bytes, n);
+
+	return CRC32_COMBINE_OP_FUNCTION(delta, old_crc,
+			CRC32_COMBINE_GEN_FUNCTION(total_len - offset - n));
+}
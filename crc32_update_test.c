@@ -0,0 +1,106 @@
+/*
+ * Test updating the CRC of a buffer after a partial overwrite against the
+ * reference model.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of either:
+ *
+ *  a) the GNU General Public License as published by the Free Software
+ *     Foundation; either version 2 of the License, or (at your option)
+ *     any later version, or
+ *  b) the Apache License, Version 2.0
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "crcmodel.h"
+#include "crc32_constants.h"
+
+#define MAX_CRC_LENGTH	(64*1024)
+#define MAX_UPDATE	1024
+#define ITERATIONS	1000
+
+unsigned int crc32_vpmsum_update(unsigned int old_crc, unsigned long total_len,
+				 unsigned long offset,
+				 const unsigned char *old_bytes,
+				 const unsigned char *new_bytes,
+				 unsigned long n);
+
+static unsigned int verify_crc(unsigned int crc, unsigned char *p,
+			       unsigned long len)
+{
+	cm_t cm_t = { 0, };
+	int i;
+
+	cm_t.cm_width = 32;
+	cm_t.cm_poly  = CRC;
+	cm_t.cm_init  = crc;
+#ifdef REFLECT
+	cm_t.cm_refin = TRUE;
+	cm_t.cm_refot = TRUE;
+#else
+	cm_t.cm_refin = FALSE;
+	cm_t.cm_refot = FALSE;
+#endif
+#ifdef CRC_XOR
+	cm_t.cm_init ^= 0xffffffff;
+	cm_t.cm_xorot = 0xffffffff;
+#else
+	cm_t.cm_xorot = 0x0;
+#endif
+	cm_ini(&cm_t);
+
+	for (i = 0; i < len; i++)
+		cm_nxt(&cm_t, p[i]);
+
+	return cm_crc(&cm_t);
+}
+
+int main(void)
+{
+	unsigned char *data, old_bytes[MAX_UPDATE];
+	unsigned long i, j;
+	int ret = 0;
+
+	data = malloc(MAX_CRC_LENGTH);
+	if (!data) {
+		perror("malloc");
+		exit(1);
+	}
+
+	srandom(1);
+
+	for (i = 0; i < MAX_CRC_LENGTH; i++)
+		data[i] = random() & 0xff;
+
+	for (i = 0; i < ITERATIONS; i++) {
+		unsigned long len, offset, n;
+		unsigned int init, old_crc, crc, verify;
+
+		len = 1 + random() % MAX_CRC_LENGTH;
+		offset = random() % len;
+		n = random() % (len - offset + 1);
+		if (n > MAX_UPDATE)
+			n = random() % (MAX_UPDATE + 1);
+
+		init = random();
+		old_crc = verify_crc(init, data, len);
+
+		memcpy(old_bytes, data + offset, n);
+		for (j = 0; j < n; j++)
+			data[offset + j] = random() & 0xff;
+
+		crc = crc32_vpmsum_update(old_crc, len, offset, old_bytes,
+					  data + offset, n);
+		verify = verify_crc(init, data, len);
+		if (crc != verify) {
+			printf("FAILURE: got 0x%08x expected 0x%08x (len %lu offset %lu n %lu)\n",
+			       crc, verify, len, offset, n);
+			ret = 1;
+		}
+	}
+
+	free(data);
+
+	return ret;
+}
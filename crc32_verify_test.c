@@ -0,0 +1,150 @@
+/*
+ * Test checking the segments of a buffer against stored CRCs, with some
+ * of the stored CRCs corrupted, against the reference model.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of either:
+ *
+ *  a) the GNU General Public License as published by the Free Software
+ *     Foundation; either version 2 of the License, or (at your option)
+ *     any later version, or
+ *  b) the Apache License, Version 2.0
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include "crcmodel.h"
+#include "crc32_constants.h"
+#include "crc32_multi.h"
+
+#define MAX_SEGMENTS	70
+#define MAX_SEG_LENGTH	600
+#define ITERATIONS	2000
+
+static unsigned int verify_crc(unsigned int crc, const unsigned char *p,
+			       unsigned long len)
+{
+	cm_t cm_t = { 0, };
+	int i;
+
+	cm_t.cm_width = 32;
+	cm_t.cm_poly  = CRC;
+	cm_t.cm_init  = crc;
+#ifdef REFLECT
+	cm_t.cm_refin = TRUE;
+	cm_t.cm_refot = TRUE;
+#else
+	cm_t.cm_refin = FALSE;
+	cm_t.cm_refot = FALSE;
+#endif
+#ifdef CRC_XOR
+	cm_t.cm_init ^= 0xffffffff;
+	cm_t.cm_xorot = 0xffffffff;
+#else
+	cm_t.cm_xorot = 0x0;
+#endif
+	cm_ini(&cm_t);
+
+	for (i = 0; i < len; i++)
+		cm_nxt(&cm_t, p[i]);
+
+	return cm_crc(&cm_t);
+}
+
+#define BITMAP_LONGS	((MAX_SEGMENTS + CRC32_VERIFY_BITS - 1) / CRC32_VERIFY_BITS)
+
+int main(void)
+{
+	unsigned char *data;
+	unsigned int expected[MAX_SEGMENTS];
+	int corrupt[MAX_SEGMENTS];
+	unsigned long bad[BITMAP_LONGS + 1];
+	unsigned long i, size;
+	int ret = 0;
+
+	size = MAX_SEGMENTS * MAX_SEG_LENGTH + 16;
+	data = malloc(size);
+	if (!data) {
+		perror("malloc");
+		exit(1);
+	}
+
+	srandom(1);
+
+	for (i = 0; i < size; i++)
+		data[i] = random() & 0xff;
+
+	for (i = 0; i < ITERATIONS; i++) {
+		const unsigned char *p = data + random() % 16;
+		unsigned long seg, len, nseg, n, k, nbad, first;
+		unsigned int flags = i & 1 ? CRC32_VERIFY_STOP : 0;
+
+		seg = 1 + random() % MAX_SEG_LENGTH;
+		len = random() % (seg * (MAX_SEGMENTS - 1) + 1);
+		nseg = (len + seg - 1) / seg;
+
+		nbad = 0;
+		first = nseg;
+		for (k = 0; k < nseg; k++) {
+			n = len - k * seg < seg ? len - k * seg : seg;
+			expected[k] = verify_crc(0, p + k * seg, n);
+
+			/* Corrupt about one in 16 */
+			corrupt[k] = !(random() % 16);
+			if (corrupt[k]) {
+				expected[k] ^= 1 << (random() % 32);
+				if (first == nseg)
+					first = k;
+				nbad++;
+			}
+		}
+
+		/* Catch writes past the end of the bitmap */
+		bad[BITMAP_LONGS] = 0x5a5a5a5a;
+
+		n = crc32_vpmsum_verify(p, len, seg, expected, bad, flags);
+
+		if (bad[BITMAP_LONGS] != 0x5a5a5a5a) {
+			printf("FAILURE: bitmap overrun (len %lu seg %lu)\n",
+			       len, seg);
+			ret = 1;
+		}
+
+		if (flags & CRC32_VERIFY_STOP) {
+			/* Everything up to the first bad segment is checked */
+			if (nbad ? (n < 1 || !CRC32_VERIFY_BAD(bad, first)) : n) {
+				printf("FAILURE: stop returned %lu, first bad %lu (len %lu seg %lu)\n",
+				       n, first, len, seg);
+				ret = 1;
+			}
+
+			for (k = 0; k < first; k++) {
+				if (CRC32_VERIFY_BAD(bad, k)) {
+					printf("FAILURE: segment %lu flagged (len %lu seg %lu)\n",
+					       k, len, seg);
+					ret = 1;
+				}
+			}
+
+			continue;
+		}
+
+		if (n != nbad) {
+			printf("FAILURE: got %lu bad segments expected %lu (len %lu seg %lu)\n",
+			       n, nbad, len, seg);
+			ret = 1;
+		}
+
+		for (k = 0; k < nseg; k++) {
+			if (CRC32_VERIFY_BAD(bad, k) != corrupt[k]) {
+				printf("FAILURE: segment %lu flagged %lu expected %d (len %lu seg %lu)\n",
+				       k, CRC32_VERIFY_BAD(bad, k), corrupt[k],
+				       len, seg);
+				ret = 1;
+			}
+		}
+	}
+
+	free(data);
+
+	return ret;
+}
@@ -9,7 +9,7 @@
  *     any later version, or
  *  b) the Apache License, Version 2.0
  */
-#define CRC_TABLE
+#define CRC_SLICE_TABLE 8
 
 #ifdef CRC32_CONSTANTS_HEADER
 #include CRC32_CONSTANTS_HEADER
@@ -21,23 +21,8 @@
 #define VMX_ALIGN	16
 #define VMX_ALIGN_MASK	(VMX_ALIGN-1)
 
-#ifdef REFLECT
-static unsigned int crc32_align(unsigned int crc, unsigned char *p,
-			       unsigned long len)
-{
-	while (len--)
-		crc = crc_table[(crc ^ *p++) & 0xff] ^ (crc >> 8);
-	return crc;
-}
-#else
-static unsigned int crc32_align(unsigned int crc, unsigned char *p,
-				unsigned long len)
-{
-	while (len--)
-		crc = crc_table[((crc >> 24) ^ *p++) & 0xff] ^ (crc << 8);
-	return crc;
-}
-#endif
+#include "crc32_slice.h"
+#include "crc32_prefetch.h"
 
 #ifndef CRC32_FUNCTION
 #define CRC32_FUNCTION     crc32_vpmsum
@@ -71,6 +56,7 @@ unsigned int CRC32_FUNCTION(unsigned int crc, unsigned char *p,
 		p += prealign;
 	}
 
+	crc32_prefetch_stream(p, len);
 	crc = CRC32_FUNCTION_ASM(crc, p, len & ~VMX_ALIGN_MASK);
 
 	tail = len & VMX_ALIGN_MASK;
@@ -0,0 +1,187 @@
+/*
+ * Generate the constants for the 64 bit CRC in vec_crc64.c.
+ *
+ * This is crc32_constants.c for a degree 64 polynomial. Only the fixed
+ * distance folding constants are generated, since vec_crc64.c folds 8
+ * streams forward by 1024 bits like vec_crc32_fold.c, plus the Barrett
+ * constants and slice by 8 tables for the unaligned head and tail.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of either:
+ *
+ *  a) the GNU General Public License as published by the Free Software
+ *     Foundation; either version 2 of the License, or (at your option)
+ *     any later version, or
+ *  b) the Apache License, Version 2.0
+ */
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include <getopt.h>
+#include "poly_arithmetic.h"
+
+static void create_slice_table(unsigned long crc, int reflect)
+{
+	uint64_t t[8][256];
+	int i, k;
+
+	crc64_slice_table(crc, reflect, t, 8);
+
+	printf("#ifdef CRC64_SLICE_TABLE\n");
+	printf("static const unsigned long crc64_slice_table[8][256] = {");
+
+	for (k = 0; k < 8; k++) {
+		printf("\n{");
+		for (i = 0; i < 256; i++) {
+			if (!(i % 2))
+				printf("\n\t");
+			else
+				printf(" ");
+			printf("0x%016lxUL,", t[k][i]);
+		}
+		printf("\n},");
+	}
+
+	printf("\n};\n\n");
+	printf("#endif /* CRC64_SLICE_TABLE */\n");
+}
+
+/*
+ * Constants to fold 128 bit chunks forward by CRC_FOLD_DISTANCE,
+ * CRC_FOLD_DISTANCE/2 ... 128 bits, and finally by 64 bits to append the
+ * trailing 64 bits of zeros, leaving 128 bits for the Barrett reduction.
+ *
+ * With a 64 bit CRC the remainders are a full doubleword, so there is no
+ * room to shift a reflected constant left one bit like crc32_constants.c
+ * does. The product of two 64 bit reflected values is 127 bits, one bit
+ * short, so we fold by one bit less instead (x^(n-1), x^(n+63)), which
+ * lines the product up with the data.
+ */
+static void print_fold_constants(unsigned long crc, int reflected)
+{
+	unsigned long hi[CRC_FOLD_CONSTANTS], lo[CRC_FOLD_CONSTANTS];
+	unsigned int i, n;
+	int le;
+
+	for (i = 0, n = CRC_FOLD_DISTANCE; n >= 64; i++, n /= 2) {
+		if (reflected) {
+			hi[i] = reflect(get_remainder(crc, 64, n-1), 64);
+			lo[i] = reflect(get_remainder(crc, 64, n+63), 64);
+		} else {
+			hi[i] = get_remainder(crc, 64, n+64);
+			lo[i] = get_remainder(crc, 64, n);
+		}
+	}
+
+	printf("\n/* Fold 128 bit chunks forward by a fixed distance, "
+		"then by 64 bits */\n");
+	printf("\nstatic const __vector unsigned long long vcrc64_fold_const[%d]\n",
+		CRC_FOLD_CONSTANTS);
+	printf("\t__attribute__((aligned (16))) = {\n");
+
+	for (le = 1; le >= 0; le--) {
+		printf(le ? "#ifdef __LITTLE_ENDIAN__\n" :
+			"#else /* __LITTLE_ENDIAN__ */\n");
+
+		for (i = 0, n = CRC_FOLD_DISTANCE; n >= 64; i++, n /= 2) {
+			if (reflected)
+				printf("\t\t/* x^%u mod p(x)` , x^%u mod p(x)` */\n",
+					n-1, n+63);
+			else
+				printf("\t\t/* x^%u mod p(x) , x^%u mod p(x) */\n",
+					n+64, n);
+			printf("\t\t{ 0x%016lx, 0x%016lx }%s\n",
+				le ? lo[i] : hi[i], le ? hi[i] : lo[i],
+				n != 64 ? "," : "");
+		}
+	}
+
+	printf("#endif /* __LITTLE_ENDIAN__ */\n");
+	printf("\t};\n");
+}
+
+/*
+ * The Barrett constants are the low 64 bits of x^128 div p(x) and of p(x)
+ * (the x^64 terms are implied), in the least significant doubleword.
+ */
+static void print_barrett_constants(unsigned long crc, int reflected)
+{
+	unsigned long m = get_quotient(crc, 64, 128);
+	unsigned long n = crc;
+
+	if (reflected) {
+		m = reflect(m, 64);
+		n = reflect(n, 64);
+	}
+
+	printf("\n/* Barrett constants */\n");
+	printf("\nstatic const __vector unsigned long long vcrc64_barrett_const[2]\n");
+	printf("\t__attribute__((aligned (16))) = {\n");
+	printf("\t\t/* x^128 div p(x)%s, p(x)%s */\n",
+		reflected ? "`" : "", reflected ? "`" : "");
+	printf("#ifdef __LITTLE_ENDIAN__\n");
+	printf("\t\t{ 0x%016lx, 0x%016lx },\n", m, 0UL);
+	printf("\t\t{ 0x%016lx, 0x%016lx }\n", n, 0UL);
+	printf("#else /* __LITTLE_ENDIAN__ */\n");
+	printf("\t\t{ 0x%016lx, 0x%016lx },\n", 0UL, m);
+	printf("\t\t{ 0x%016lx, 0x%016lx }\n", 0UL, n);
+	printf("#endif /* __LITTLE_ENDIAN__ */\n");
+	printf("\t};\n");
+}
+
+static void usage(char *argv[])
+{
+	print_usage(argv);
+	fprintf(stderr, "Usual usage is to redirect this into a file called crc64_constants.h\n");
+}
+
+int main(int argc, char *argv[])
+{
+	int reflect = 0;
+	int xor = 0;
+	unsigned long crc;
+
+	while (1) {
+		signed char c = getopt(argc, argv, "rx");
+		if (c < 0)
+			break;
+
+		switch (c) {
+		case 'r':
+			reflect = 1;
+			break;
+
+		case 'x':
+			xor = 1;
+			break;
+
+		default:
+			usage(argv);
+			exit(1);
+			break;
+		}
+	}
+
+	if ((argc - optind) != 1) {
+		usage(argv);
+		exit(1);
+	}
+
+	crc = strtoul(argv[optind], NULL, 0);
+	print_header(argc, argv);
+
+	printf("#define CRC64 0x%016lxUL\n", crc);
+	if (xor)
+		printf("#define CRC64_XOR\n");
+	if (reflect)
+		printf("#define CRC64_REFLECT\n");
+	printf("\n");
+	create_slice_table(crc, reflect);
+
+	printf("#ifdef POWER8_INTRINSICS\n");
+	print_fold_constants(crc, reflect);
+	print_barrett_constants(crc, reflect);
+	printf("#endif /* POWER8_INTRINSICS */\n");
+
+	return 0;
+}
@@ -0,0 +1,102 @@
+/*
+ * Test the 64 bit CRC against the reference model.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of either:
+ *
+ *  a) the GNU General Public License as published by the Free Software
+ *     Foundation; either version 2 of the License, or (at your option)
+ *     any later version, or
+ *  b) the Apache License, Version 2.0
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include "crcmodel.h"
+
+#ifdef CRC64_CONSTANTS_HEADER
+#include CRC64_CONSTANTS_HEADER
+#else
+#include "crc64_constants.h"
+#endif
+
+#ifndef CRC64_FUNCTION
+#define CRC64_FUNCTION	crc64_vpmsum
+#endif
+
+#define MAX_CRC_LENGTH	70000
+#define ITERATIONS	2000
+
+unsigned long CRC64_FUNCTION(unsigned long crc, const unsigned char *p,
+			     unsigned long len);
+
+static unsigned long verify_crc(unsigned long crc, const unsigned char *p,
+				unsigned long len)
+{
+	cm_t cm_t = { 0, };
+	int i;
+
+	cm_t.cm_width = 64;
+	cm_t.cm_poly  = CRC64;
+	cm_t.cm_init  = crc;
+#ifdef CRC64_REFLECT
+	cm_t.cm_refin = TRUE;
+	cm_t.cm_refot = TRUE;
+#else
+	cm_t.cm_refin = FALSE;
+	cm_t.cm_refot = FALSE;
+#endif
+#ifdef CRC64_XOR
+	cm_t.cm_init ^= 0xffffffffffffffffUL;
+	cm_t.cm_xorot = 0xffffffffffffffffUL;
+#else
+	cm_t.cm_xorot = 0x0;
+#endif
+	cm_ini(&cm_t);
+
+	for (i = 0; i < len; i++)
+		cm_nxt(&cm_t, p[i]);
+
+	return cm_crc(&cm_t);
+}
+
+int main(void)
+{
+	unsigned char *data;
+	unsigned long i, size;
+	int ret = 0;
+
+	size = MAX_CRC_LENGTH + 16;
+	data = malloc(size);
+	if (!data) {
+		perror("malloc");
+		exit(1);
+	}
+
+	srandom(1);
+
+	for (i = 0; i < size; i++)
+		data[i] = random() & 0xff;
+
+	for (i = 0; i < ITERATIONS; i++) {
+		const unsigned char *p = data + random() % 16;
+		unsigned long init, crc, verify, len;
+
+		/* Favour the short lengths, where the edge cases are */
+		len = random() % (i % 16 ? 1000 : MAX_CRC_LENGTH);
+
+		init = ((unsigned long)random() << 32) ^ random();
+
+		crc = CRC64_FUNCTION(init, p, len);
+		verify = verify_crc(init, p, len);
+
+		if (crc != verify) {
+			printf("FAILURE: got 0x%016lx expected 0x%016lx (len %lu)\n",
+			       crc, verify, len);
+			ret = 1;
+		}
+	}
+
+	free(data);
+
+	return ret;
+}
@@ -0,0 +1,258 @@
+/*
+ * Calculate the CRC of any 32 bit polynomial chosen at run time.
+ *
+ * Everything else here bakes one polynomial in at build time, through
+ * the crc32_constants.h a file is compiled against. crc_engine_init()
+ * instead computes the constants for poly, reflected and xor into a
+ * struct crc_engine, with the same poly_arithmetic.c routines the
+ * generator uses, and crc_engine_crc() takes them from there. One binary
+ * can then checksum with as many polynomials as it likes.
+ *
+ * The kernel is vec_crc32_fold.c: 8 streams folded forward by 1024 bits
+ * at a time. That needs only the 5 fold and 2 Barrett constants, against
+ * the 4 kB vcrc_const table of vec_crc32.c, so an engine is cheap to set
+ * up and small enough to keep one per polynomial. The bit order is chosen
+ * at run time too: the data always goes through a permute (a byte reverse
+ * or nothing, depending on the order and endian), and the initial value,
+ * Barrett reduction and slice by 8 head and tail branch on eng->reflect
+ * outside the loops. The fold down and reductions are the crc32_reduce.h
+ * ones, and the head and tail crc32_slice.h, given the engine's constants.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of either:
+ *
+ *  a) the GNU General Public License as published by the Free Software
+ *     Foundation; either version 2 of the License, or (at your option)
+ *     any later version, or
+ *  b) the Apache License, Version 2.0
+ */
+
+#include <altivec.h>
+#include "poly_arithmetic.h"
+#include "crc_engine.h"
+
+#define VMX_ALIGN	16
+#define VMX_ALIGN_MASK	(VMX_ALIGN-1)
+
+/* Number of 16 byte streams */
+#define ENGINE_STREAMS	8
+
+#if defined (__clang__)
+#include "clang_workaround.h"
+#else
+#define __builtin_pack_vector(a, b)  __builtin_pack_vector_int128 ((a), (b))
+#define __builtin_unpack_vector_0(a) __builtin_unpack_vector_int128 ((vector __int128_t)(a), 0)
+#define __builtin_unpack_vector_1(a) __builtin_unpack_vector_int128 ((vector __int128_t)(a), 1)
+#endif
+
+#include "crc32_reduce.h"
+#include "crc32_slice.h"
+
+#define CRC32_PRAGMA(x)	_Pragma(#x)
+#define CRC32_UNROLL(n)	CRC32_PRAGMA(GCC unroll n)
+
+#define VEC(a, i)	(((const __vector unsigned long long *)(a))[i])
+
+/* Store a constant the way crc32_constants prints it for this endian */
+static void crc_engine_set(unsigned long long *v, unsigned long hi,
+			   unsigned long lo)
+{
+#ifdef __LITTLE_ENDIAN__
+	v[0] = lo;
+	v[1] = hi;
+#else
+	v[0] = hi;
+	v[1] = lo;
+#endif
+}
+
+/*
+ * Initialise eng for the polynomial poly (without the x^32 term), bit
+ * reflected if reflected is set and with the input and output inverted
+ * if xor is set, ie the same constants as crc32_constants [-r] [-x] poly.
+ */
+void crc_engine_init(struct crc_engine *eng, unsigned int poly, int reflected,
+		     int xor)
+{
+	unsigned long hi[CRC_FOLD_CONSTANTS], lo[CRC_FOLD_CONSTANTS];
+	unsigned long k[2];
+	unsigned int i;
+
+	eng->poly = poly;
+	eng->reflect = reflected;
+	eng->xor = xor;
+
+	crc32_fold_constants(poly, reflected, hi, lo);
+	for (i = 0; i < CRC_FOLD_CONSTANTS; i++)
+		crc_engine_set(eng->fold[i], hi[i], lo[i]);
+
+	crc32_barrett_constants(poly, reflected, k);
+	for (i = 0; i < 2; i++)
+		crc_engine_set(eng->barrett[i], 0, k[i]);
+
+	/* The byte reverse of BYTESWAP_DATA, or the identity */
+#ifdef __LITTLE_ENDIAN__
+	if (!reflected)
+		crc_engine_set(eng->vperm, 0x0001020304050607UL,
+			0x08090A0B0C0D0E0FUL);
+	else
+		crc_engine_set(eng->vperm, 0x0F0E0D0C0B0A0908UL,
+			0x0706050403020100UL);
+#else
+	if (reflected)
+		crc_engine_set(eng->vperm, 0x0F0E0D0C0B0A0908UL,
+			0x0706050403020100UL);
+	else
+		crc_engine_set(eng->vperm, 0x0001020304050607UL,
+			0x08090A0B0C0D0E0FUL);
+#endif
+
+	/* Slice by 8 tables for the head and tail */
+	crc32_slice_table(poly, reflected, eng->slice, 8);
+}
+
+static unsigned int crc_engine_bytes(const struct crc_engine *eng,
+				     unsigned int crc, const unsigned char *p,
+				     unsigned long len)
+{
+	const unsigned int (*t)[256] = (const unsigned int (*)[256])eng->slice;
+
+	if (eng->reflect)
+		return crc32_slice(crc, p, len, t, 8, 1);
+	else
+		return crc32_slice(crc, p, len, t, 8, 0);
+}
+
+static unsigned int __attribute__ ((aligned (32)))
+__crc_engine_vpmsum(const struct crc_engine *eng, unsigned int crc,
+		    const void *p, unsigned long len);
+
+unsigned int crc_engine_crc(const struct crc_engine *eng, unsigned int crc,
+			    const unsigned char *p, unsigned long len)
+{
+	unsigned int prealign;
+	unsigned int tail;
+
+	if (eng->xor)
+		crc ^= 0xffffffff;
+
+	if (len < VMX_ALIGN + VMX_ALIGN_MASK) {
+		crc = crc_engine_bytes(eng, crc, p, len);
+		goto out;
+	}
+
+	if ((unsigned long)p & VMX_ALIGN_MASK) {
+		prealign = VMX_ALIGN - ((unsigned long)p & VMX_ALIGN_MASK);
+		crc = crc_engine_bytes(eng, crc, p, prealign);
+		len -= prealign;
+		p += prealign;
+	}
+
+	crc = __crc_engine_vpmsum(eng, crc, p, len & ~VMX_ALIGN_MASK);
+
+	tail = len & VMX_ALIGN_MASK;
+	if (tail) {
+		p += len & ~VMX_ALIGN_MASK;
+		crc = crc_engine_bytes(eng, crc, p, tail);
+	}
+
+out:
+	if (eng->xor)
+		crc ^= 0xffffffff;
+
+	return crc;
+}
+
+/*
+ * Checksum len bytes at p, 16 byte aligned and a multiple of 16 bytes.
+ * See vec_crc32_fold.c.
+ */
+static unsigned int __attribute__ ((aligned (32)))
+__crc_engine_vpmsum(const struct crc_engine *eng, unsigned int crc,
+		    const void *p, unsigned long len) {
+
+	const __vector unsigned long long *fold_const =
+		(const __vector unsigned long long *)eng->fold;
+	const __vector unsigned long long *barrett_const =
+		(const __vector unsigned long long *)eng->barrett;
+
+	const __vector unsigned char vperm = (__vector unsigned char)VEC(eng->vperm, 0);
+
+	/*
+	 * Fold by 1024 and 128 bits here, the rest is in crc32_fold_streams()
+	 * and crc32_reduce().
+	 */
+	const __vector unsigned long long vfold1024 = VEC(eng->fold, 0);
+	const __vector unsigned long long vfold128 = VEC(eng->fold, 3);
+
+	__vector unsigned long long vcrc;
+
+	/* v[0]-v[7] will contain our checksums */
+	__vector unsigned long long v[ENGINE_STREAMS];
+
+	__vector unsigned long long vdata0, v0;
+
+	int j;
+
+	if (len == 0)
+		return crc;
+
+	vcrc = crc32_init_vcrc(crc, eng->reflect);
+
+	if (len >= 128) {
+		CRC32_UNROLL(8)
+		for (j = 0; j < ENGINE_STREAMS; j++) {
+			v[j] = vec_ld(j * 16, (__vector unsigned long long *)p);
+			v[j] = vec_perm(v[j], v[j], vperm);
+		}
+
+		/* xor in initial value */
+		v[0] = vec_xor(v[0], vcrc);
+
+		p = (char *)p + 128;
+		len -= 128;
+
+		/*
+		 * main loop. Every 128 bytes we fold each chunk forward by 1024
+		 * bits and xor in the next 16 bytes of its stream.
+		 */
+		while (len >= 128) {
+			CRC32_UNROLL(8)
+			for (j = 0; j < ENGINE_STREAMS; j++) {
+				vdata0 = vec_ld(j * 16, (__vector unsigned long long *)p);
+				vdata0 = vec_perm(vdata0, vdata0, vperm);
+
+				v[j] = vec_xor(vdata0,
+					__builtin_crypto_vpmsumd(v[j], vfold1024));
+			}
+
+			p = (char *)p + 128;
+			len -= 128;
+		}
+
+		/* Fold the 8 chunks into one: by 512, then 256, then 128 bits. */
+		vdata0 = crc32_fold_streams(v, fold_const);
+	} else {
+		vdata0 = vec_ld(0, (__vector unsigned long long *)p);
+		vdata0 = vec_perm(vdata0, vdata0, vperm);
+
+		/* xor in initial value */
+		vdata0 = vec_xor(vdata0, vcrc);
+
+		p = (char *)p + 16;
+		len -= 16;
+	}
+
+	/* Now fold in the tail (0-112 bytes), 16 bytes at a time. */
+	while (len) {
+		v0 = vec_ld(0, (__vector unsigned long long *)p);
+		v0 = vec_perm(v0, v0, vperm);
+
+		vdata0 = vec_xor(v0, __builtin_crypto_vpmsumd(vdata0, vfold128));
+
+		p = (char *)p + 16;
+		len -= 16;
+	}
+
+	return crc32_reduce(vdata0, fold_const, barrett_const, eng->reflect);
+}
@@ -0,0 +1,34 @@
+#ifndef CRC_ENGINE_H
+#define CRC_ENGINE_H
+
+/*
+ * Constants for one 32 bit polynomial, filled in at run time by
+ * crc_engine_init(). The contents are private: the fold, reduce and
+ * Barrett constants in the layout crc32_constants generates, the permute
+ * that puts the data in the bit order of the CRC, and the slice by 8
+ * tables for the head and tail.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of either:
+ *
+ *  a) the GNU General Public License as published by the Free Software
+ *     Foundation; either version 2 of the License, or (at your option)
+ *     any later version, or
+ *  b) the Apache License, Version 2.0
+ */
+struct crc_engine {
+	unsigned long long fold[5][2] __attribute__ ((aligned (16)));
+	unsigned long long barrett[2][2] __attribute__ ((aligned (16)));
+	unsigned long long vperm[2] __attribute__ ((aligned (16)));
+	unsigned int slice[8][256];
+	unsigned int poly;
+	int reflect;
+	int xor;
+};
+
+void crc_engine_init(struct crc_engine *eng, unsigned int poly, int reflected,
+		     int xor);
+unsigned int crc_engine_crc(const struct crc_engine *eng, unsigned int crc,
+			    const unsigned char *p, unsigned long len);
+
+#endif
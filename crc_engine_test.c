@@ -0,0 +1,131 @@
+/*
+ * Test the run time CRC engine against the reference model, for the
+ * common polynomials and a set of random ones in both bit orders.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of either:
+ *
+ *  a) the GNU General Public License as published by the Free Software
+ *     Foundation; either version 2 of the License, or (at your option)
+ *     any later version, or
+ *  b) the Apache License, Version 2.0
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include "crcmodel.h"
+#include "crc_engine.h"
+
+#define MAX_CRC_LENGTH	70000
+#define ITERATIONS	200
+#define RANDOM_POLYS	16
+
+static const struct {
+	unsigned int poly;
+	int reflect;
+	int xor;
+} polys[] = {
+	{ 0x04C11DB7, 1, 1 },	/* CRC-32 */
+	{ 0x1EDC6F41, 1, 1 },	/* CRC-32C */
+	{ 0x741B8CD7, 1, 1 },	/* CRC-32K */
+	{ 0x04C11DB7, 0, 1 },	/* CRC-32/BZIP2 */
+	{ 0x04C11DB7, 0, 0 },	/* CRC-32/MPEG-2 without the initial value */
+	{ 0x814141AB, 0, 0 },	/* CRC-32Q */
+};
+
+static unsigned int verify_crc(const struct crc_engine *eng, unsigned int crc,
+			       const unsigned char *p, unsigned long len)
+{
+	cm_t cm_t = { 0, };
+	int i;
+
+	cm_t.cm_width = 32;
+	cm_t.cm_poly  = eng->poly;
+	cm_t.cm_init  = crc;
+	cm_t.cm_refin = eng->reflect ? TRUE : FALSE;
+	cm_t.cm_refot = eng->reflect ? TRUE : FALSE;
+	if (eng->xor) {
+		cm_t.cm_init ^= 0xffffffff;
+		cm_t.cm_xorot = 0xffffffff;
+	} else {
+		cm_t.cm_xorot = 0x0;
+	}
+	cm_ini(&cm_t);
+
+	for (i = 0; i < len; i++)
+		cm_nxt(&cm_t, p[i]);
+
+	return cm_crc(&cm_t);
+}
+
+static int test_engine(const struct crc_engine *eng, const unsigned char *data)
+{
+	unsigned long i;
+	int ret = 0;
+
+	for (i = 0; i < ITERATIONS; i++) {
+		const unsigned char *p = data + random() % 16;
+		unsigned int init, crc, verify;
+		unsigned long len;
+
+		/* Favour the short lengths, where the edge cases are */
+		len = random() % (i % 16 ? 1000 : MAX_CRC_LENGTH);
+
+		init = random();
+
+		crc = crc_engine_crc(eng, init, p, len);
+		verify = verify_crc(eng, init, p, len);
+
+		if (crc != verify) {
+			printf("FAILURE: poly 0x%08x%s%s got 0x%08x expected 0x%08x (len %lu)\n",
+			       eng->poly, eng->reflect ? " reflect" : "",
+			       eng->xor ? " xor" : "", crc, verify, len);
+			ret = 1;
+		}
+	}
+
+	return ret;
+}
+
+int main(void)
+{
+	struct crc_engine eng;
+	unsigned char *data;
+	unsigned long i, size;
+	int ret = 0;
+
+	size = MAX_CRC_LENGTH + 16;
+	data = malloc(size);
+	if (!data) {
+		perror("malloc");
+		exit(1);
+	}
+
+	srandom(1);
+
+	for (i = 0; i < size; i++)
+		data[i] = random() & 0xff;
+
+	for (i = 0; i < sizeof(polys) / sizeof(polys[0]); i++) {
+		crc_engine_init(&eng, polys[i].poly, polys[i].reflect,
+				polys[i].xor);
+		ret |= test_engine(&eng, data);
+	}
+
+	for (i = 0; i < RANDOM_POLYS; i++) {
+		/* An odd polynomial, ie with an x^0 term */
+		crc_engine_init(&eng, random() | 1, i & 1, (i >> 1) & 1);
+		ret |= test_engine(&eng, data);
+	}
+
+	/* The check value of CRC-32, 0xcbf43926 */
+	crc_engine_init(&eng, 0x04C11DB7, 1, 1);
+	if (crc_engine_crc(&eng, 0, (const unsigned char *)"123456789", 9) !=
+	    0xcbf43926) {
+		printf("FAILURE: CRC-32 check value\n");
+		ret = 1;
+	}
+
+	free(data);
+
+	return ret;
+}
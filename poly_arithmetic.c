@@ -6,6 +6,13 @@
 
 #include <stdio.h>
 #include <inttypes.h>
+#include "poly_arithmetic.h"
+
+/* x^deg - 1, without shifting a uint64_t by 64 when deg is 64. */
+static uint64_t degmask(unsigned int deg)
+{
+	return deg < 64 ? ((uint64_t) 1 << deg) - 1 : ~(uint64_t) 0;
+}
 
 /* Return x^n mod p(x) over GF(2).  x^deg is the highest power of x in p(x).
    The positions of the bits set in poly represent the remaining powers of x in
@@ -18,9 +25,9 @@ uint64_t xnmodp(unsigned int n, uint64_t poly, unsigned int deg,
 
 	if (n < deg) {
 		*div = 0;
-		return poly;
+		return (uint64_t)1 << n;
 	}
-	mask = ((uint64_t) 1 << deg) - 1;
+	mask = degmask(deg);
 	poly &= mask;
 	mod = poly;
 	*div = 1;
@@ -35,6 +42,43 @@ uint64_t xnmodp(unsigned int n, uint64_t poly, unsigned int deg,
 	return mod & mask;
 }
 
+/* Return a(x) * b(x) mod p(x) over GF(2), for a(x) and b(x) already reduced
+   mod p(x). x^deg is the highest power of x in p(x). */
+uint64_t multmodp(uint64_t a, uint64_t b, uint64_t poly, unsigned int deg)
+{
+	uint64_t mask, prod = 0;
+	unsigned int i;
+
+	mask = degmask(deg);
+	poly &= mask;
+	for (i = deg; i-- > 0; ) {
+		/* prod = prod * x mod p(x), then add in this bit of b(x) */
+		if ((prod >> (deg - 1)) & 1)
+			prod = ((prod << 1) & mask) ^ poly;
+		else
+			prod = (prod << 1) & mask;
+		if ((b >> i) & 1)
+			prod ^= a;
+	}
+	return prod;
+}
+
+/* Return x^(2^k) mod p(x) over GF(2), by repeated squaring. */
+uint64_t x2kmodp(unsigned int k, uint64_t poly, unsigned int deg)
+{
+	uint64_t mask = degmask(deg);
+	uint64_t r;
+
+	/* x^1 */
+	r = 2;
+	if (deg == 1)
+		r = poly & mask;
+
+	while (k--)
+		r = multmodp(r, r, poly, deg);
+	return r;
+}
+
 /* Reflect the data about the center bit. */
 uint64_t reflect(uint64_t data, unsigned int nr_bits)
 {
@@ -67,6 +111,167 @@ unsigned long get_quotient(uint64_t crc, unsigned int bits, unsigned int n)
 	return div;
 }
 
+/*
+ * Constants to fold 128 bit chunks of a 32 bit CRC forward by
+ * CRC_FOLD_DISTANCE, CRC_FOLD_DISTANCE/2 ... 128 bits, followed by the
+ * constants to reduce the final 128 bits to 64 bits (shifting 32 bits to
+ * include the trailing 32 bits of zeros). hi[i] and lo[i] are the high and
+ * low doublewords of constant i, CRC_FOLD_CONSTANTS in all.
+ *
+ * The reflected product lands 32 bits below the data, so in the reflected
+ * case we fold by 32 bits less (and 32 bits more for the other doubleword).
+ * This saves realigning the product after every fold.
+ */
+void crc32_fold_constants(uint64_t crc, int reflected, unsigned long *hi,
+			  unsigned long *lo)
+{
+	unsigned long a, b, c, d;
+	unsigned int i, n;
+
+	for (i = 0, n = CRC_FOLD_DISTANCE; n >= 128; i++, n /= 2) {
+		if (reflected) {
+			hi[i] = reflect(get_remainder(crc, 32, n-32), 32) << 1;
+			lo[i] = reflect(get_remainder(crc, 32, n+32), 32) << 1;
+		} else {
+			hi[i] = get_remainder(crc, 32, n+64);
+			lo[i] = get_remainder(crc, 32, n);
+		}
+	}
+
+	if (reflected) {
+		a = reflect(get_remainder(crc, 32, 32), 32);
+		b = reflect(get_remainder(crc, 32, 64), 32);
+		c = reflect(get_remainder(crc, 32, 96), 32);
+		d = reflect(get_remainder(crc, 32, 128), 32);
+	} else {
+		a = get_remainder(crc, 32, 128);
+		b = get_remainder(crc, 32, 96);
+		c = get_remainder(crc, 32, 64);
+		d = get_remainder(crc, 32, 32);
+	}
+	hi[i] = (a << 32) | b;
+	lo[i] = (c << 32) | d;
+}
+
+/*
+ * The Barrett constants of a 32 bit CRC: k[0] = m = x^64 div p(x) and
+ * k[1] = n = p(x), each reflected as 33 bit values if need be.
+ */
+void crc32_barrett_constants(uint64_t crc, int reflected, unsigned long *k)
+{
+	k[0] = get_quotient(crc, 32, 64);
+	k[1] = (1UL << 32) | crc;
+
+	if (reflected) {
+		k[0] = reflect(k[0], 33);
+		k[1] = reflect(k[1], 33);
+	}
+}
+
+/* The byte table (crc_table) of a 32 bit CRC: the CRC of each byte value. */
+void crc32_byte_table(uint64_t crc, int reflected, unsigned int *table)
+{
+	unsigned int i, j, r;
+	unsigned int rcrc = reflect(crc, 32);
+
+	for (i = 0; i < 256; i++) {
+		if (reflected) {
+			r = i;
+			for (j = 0; j < 8; j++)
+				r = (r & 1) ? (r >> 1) ^ rcrc : r >> 1;
+		} else {
+			r = i << 24;
+			for (j = 0; j < 8; j++)
+				r = (r & 0x80000000) ? (r << 1) ^ crc : r << 1;
+		}
+		table[i] = r;
+	}
+}
+
+/*
+ * n slicing tables of a 32 bit CRC: entry i of table k is the CRC of byte i
+ * followed by k zero bytes, so table 0 is the byte table.
+ */
+void crc32_slice_table(uint64_t crc, int reflected, unsigned int (*table)[256],
+		       unsigned int n)
+{
+	unsigned int i, k;
+
+	crc32_byte_table(crc, reflected, table[0]);
+
+	for (k = 1; k < n; k++) {
+		for (i = 0; i < 256; i++) {
+			if (reflected)
+				table[k][i] = table[0][table[k-1][i] & 0xff] ^
+					(table[k-1][i] >> 8);
+			else
+				table[k][i] = table[0][table[k-1][i] >> 24] ^
+					(table[k-1][i] << 8);
+		}
+	}
+}
+
+/* The byte table of a 64 bit CRC: the CRC of each byte value. */
+void crc64_byte_table(uint64_t crc, int reflected, uint64_t *table)
+{
+	unsigned int i, j;
+	uint64_t r, rcrc = reflect(crc, 64);
+
+	for (i = 0; i < 256; i++) {
+		if (reflected) {
+			r = i;
+			for (j = 0; j < 8; j++)
+				r = (r & 1) ? (r >> 1) ^ rcrc : r >> 1;
+		} else {
+			r = (uint64_t)i << 56;
+			for (j = 0; j < 8; j++)
+				r = (r >> 63) ? (r << 1) ^ crc : r << 1;
+		}
+		table[i] = r;
+	}
+}
+
+/* n slicing tables of a 64 bit CRC, as crc32_slice_table() */
+void crc64_slice_table(uint64_t crc, int reflected, uint64_t (*table)[256],
+		       unsigned int n)
+{
+	unsigned int i, k;
+
+	crc64_byte_table(crc, reflected, table[0]);
+
+	for (k = 1; k < n; k++) {
+		for (i = 0; i < 256; i++) {
+			if (reflected)
+				table[k][i] = table[0][table[k-1][i] & 0xff] ^
+					(table[k-1][i] >> 8);
+			else
+				table[k][i] = table[0][table[k-1][i] >> 56] ^
+					(table[k-1][i] << 8);
+		}
+	}
+}
+
+void print_header(int argc, char *argv[])
+{
+	printf("/*\n");
+	printf("*\n");
+	printf("* THIS FILE IS GENERATED WITH\n");
+	while (argc-- > 0)
+		printf("%s ", argv++[0]);
+	printf("\n\n* This is from https://github.com/antonblanchard/crc32-vpmsum/\n");
+	printf("* DO NOT MODIFY IT MANUALLY!\n");
+	printf("*\n");
+	printf("*/\n\n");
+}
+
+void print_usage(char *argv[])
+{
+	fprintf(stderr, "Usage: %s {-r} {-x} CRC\n", argv[0]);
+	fprintf(stderr, "\tCRC without top bit\n");
+	fprintf(stderr, "\t-r bit reflect\n");
+	fprintf(stderr, "\t-x xor input and ouput\n");
+}
+
 void print_one_remainder(unsigned long rem, unsigned int n, char *str)
 {
 	printf("\t.octa 0x%032lx\t/* x^%u mod p(x)%s */\n", rem, n, str);
@@ -1,11 +1,28 @@
 #include <inttypes.h>
 
+/*
+ * Data beyond the last block is streamed through 8 parallel 128 bit chunks
+ * by folding them forward 1024 bits (8 x 128 bits) at a time. The
+ * generators also emit the constants to fold by 512, 256 and 128 bits so
+ * the 8 chunks can be combined without the full constant table, and a last
+ * one for the final reduction: CRC_FOLD_CONSTANTS in all.
+ */
+#define CRC_FOLD_DISTANCE	1024
+#define CRC_FOLD_CONSTANTS	5
+
 /* Return x^n mod p(x) over GF(2).  x^deg is the highest power of x in p(x).
    The positions of the bits set in poly represent the remaining powers of x in
    p(x).  In addition, returned in *div are as many of the least significant
-   quotient bits as will fit in a uint64_t. */
+   quotient bits as will fit in a uint64_t. deg may be up to 64. */
 uint64_t xnmodp(unsigned int n, uint64_t poly, unsigned int deg, uint64_t *div);
 
+/* Return a(x) * b(x) mod p(x) over GF(2), for a(x) and b(x) already reduced
+   mod p(x). x^deg is the highest power of x in p(x). */
+uint64_t multmodp(uint64_t a, uint64_t b, uint64_t poly, unsigned int deg);
+
+/* Return x^(2^k) mod p(x) over GF(2), by repeated squaring. */
+uint64_t x2kmodp(unsigned int k, uint64_t poly, unsigned int deg);
+
 /* Reflect the data about the center bit. */
 uint64_t reflect(uint64_t data, unsigned int nr_bits);
 
@@ -13,6 +30,33 @@ unsigned long get_remainder(uint64_t crc, unsigned int bits, unsigned int n);
 
 unsigned long get_quotient(uint64_t crc, unsigned int bits, unsigned int n);
 
+/* The fold and reduce constants (vcrc_fold_const) of a 32 bit CRC. */
+void crc32_fold_constants(uint64_t crc, int reflected, unsigned long *hi,
+			  unsigned long *lo);
+
+/* The Barrett constants (v_Barrett_const) of a 32 bit CRC. */
+void crc32_barrett_constants(uint64_t crc, int reflected, unsigned long *k);
+
+/* The byte table (crc_table) of a 32 bit CRC. */
+void crc32_byte_table(uint64_t crc, int reflected, unsigned int *table);
+
+/* The first n slicing tables (crc_slice_table) of a 32 bit CRC. */
+void crc32_slice_table(uint64_t crc, int reflected, unsigned int (*table)[256],
+		       unsigned int n);
+
+/* The byte table of a 64 bit CRC. */
+void crc64_byte_table(uint64_t crc, int reflected, uint64_t *table);
+
+/* The first n slicing tables (crc64_slice_table) of a 64 bit CRC. */
+void crc64_slice_table(uint64_t crc, int reflected, uint64_t (*table)[256],
+		       unsigned int n);
+
+/* The comment at the top of a generated header, with the command line. */
+void print_header(int argc, char *argv[]);
+
+/* The usage lines for the options every generator takes. */
+void print_usage(char *argv[]);
+
 void print_one_remainder(unsigned long rem, unsigned int n, char *str);
 
 void print_two_remainders(unsigned long rem1, unsigned int n1,
@@ -4,13 +4,25 @@
  *
  * The first step is to reduce it to 1024 bits. We do this in 8 parallel
  * chunks in order to mask the latency of the vpmsum instructions. If we
- * have more than 32 kB of data to checksum we repeat this step multiple
- * times, passing in the previous 1024 bits.
+ * have more than 32 kB of data to checksum we stream the leading data
+ * through the same 8 chunks, folding the 1024 bits forward by a fixed
+ * distance each iteration, and finish with a single 32 kB block.
  *
  * The next step is to reduce the 1024 bits to 64 bits. This step adds
  * 32 bits of 0s to the end - this matches what a CRC does. We just
  * calculate constants that land the data in this 32 bits.
  *
+ * Bytes before the first 16 byte boundary and after the last one are
+ * loaded from their aligned quadword and permuted into a zeroed vector.
+ * Rather than folding them in with a byte at a time table, we multiply
+ * the 64 bit result by x^8n (n < 16) and add the partial chunk, so even
+ * a buffer of a few bytes stays in vector registers.
+ *
+ * When built for POWER9 (-mcpu=power9) the data is loaded unaligned with
+ * lxv, so there is no head to align, and the tail is loaded with lxvl.
+ * POWER10 (-mcpu=power10) interleaves 16 streams instead of 8 and loads
+ * them in 32 byte pairs with lxvp.
+ *
  * We then use fixed point Barrett reduction to compute a mod n over GF(2)
  * for n = CRC using POWER8 instructions. We use x = 32.
  *
@@ -32,79 +44,46 @@
 #include <altivec.h>
 
 #define POWER8_INTRINSICS
-#define CRC_TABLE
 
-#ifdef CRC32_CONSTANTS_HEADER
-#include CRC32_CONSTANTS_HEADER
+/*
+ * The number of 16 byte streams the main loop interleaves: 4, 8, 12 or
+ * 16, which the constants header has tables for. POWER8 and POWER9 use
+ * the hand scheduled 8 stream loop. POWER10 can issue more vpmsums at
+ * once, so it defaults to 16 streams loaded in pairs with lxvp.
+ *
+ * CRC32_ROW_UNROLL unrolls the loop over rows of the other stream counts
+ * further, so the best combination for a CPU and SMT mode can be picked
+ * by benchmarking (see vec_crc32_bench_s% in the Makefile).
+ */
+#ifndef CRC32_STREAMS
+#ifdef _ARCH_PWR10
+#define CRC32_STREAMS	16
 #else
-#include "crc32_constants.h"
+#define CRC32_STREAMS	8
 #endif
-
-#define VMX_ALIGN	16
-#define VMX_ALIGN_MASK	(VMX_ALIGN-1)
-
-#ifdef REFLECT
-static unsigned int crc32_align(unsigned int crc, const unsigned char *p,
-			       unsigned long len)
-{
-	while (len--)
-		crc = crc_table[(crc ^ *p++) & 0xff] ^ (crc >> 8);
-	return crc;
-}
-#else
-static unsigned int crc32_align(unsigned int crc, const unsigned char *p,
-				unsigned long len)
-{
-	while (len--)
-		crc = crc_table[((crc >> 24) ^ *p++) & 0xff] ^ (crc << 8);
-	return crc;
-}
 #endif
 
-static unsigned int __attribute__ ((aligned (32)))
-__crc32_vpmsum(unsigned int crc, const void* p, unsigned long len);
-
-#ifndef CRC32_FUNCTION
-#define CRC32_FUNCTION  crc32_vpmsum
+#ifndef CRC32_ROW_UNROLL
+#define CRC32_ROW_UNROLL	1
 #endif
 
-unsigned int CRC32_FUNCTION(unsigned int crc, const unsigned char *p,
-			    unsigned long len)
-{
-	unsigned int prealign;
-	unsigned int tail;
-
-#ifdef CRC_XOR
-	crc ^= 0xffffffff;
+#ifdef CRC32_CONSTANTS_HEADER
+#include CRC32_CONSTANTS_HEADER
+#else
+#include "crc32_constants.h"
 #endif
 
-	if (len < VMX_ALIGN + VMX_ALIGN_MASK) {
-		crc = crc32_align(crc, p, len);
-		goto out;
-	}
-
-	if ((unsigned long)p & VMX_ALIGN_MASK) {
-		prealign = VMX_ALIGN - ((unsigned long)p & VMX_ALIGN_MASK);
-		crc = crc32_align(crc, p, prealign);
-		len -= prealign;
-		p += prealign;
-	}
-
-	crc = __crc32_vpmsum(crc, p, len & ~VMX_ALIGN_MASK);
+#include "crc32_prefetch.h"
 
-	tail = len & VMX_ALIGN_MASK;
-	if (tail) {
-		p += len & ~VMX_ALIGN_MASK;
-		crc = crc32_align(crc, p, tail);
-	}
+#define VMX_ALIGN	16
+#define VMX_ALIGN_MASK	(VMX_ALIGN-1)
 
-out:
-#ifdef CRC_XOR
-	crc ^= 0xffffffff;
-#endif
+/* One 16 byte chunk from each stream, and the rows in a constants block. */
+#define CRC32_ROW	(CRC32_STREAMS * 16)
+#define CRC32_BLOCK	((MAX_SIZE / CRC32_ROW) * CRC32_ROW)
 
-	return crc;
-}
+#define CRC32_PRAGMA(x)	_Pragma(#x)
+#define CRC32_UNROLL(n)	CRC32_PRAGMA(GCC unroll n)
 
 #if defined (__clang__)
 #include "clang_workaround.h"
@@ -114,6 +93,8 @@ out:
 #define __builtin_unpack_vector_1(a) __builtin_unpack_vector_int128 ((vector __int128_t)(a), 1)
 #endif
 
+#include "crc32_reduce.h"
+
 /* When we have a load-store in a single-dispatch group and address overlap
  * such that foward is not allowed (load-hit-store) the group must be flushed.
  * A group ending NOP prevents the flush.
@@ -143,24 +124,225 @@ static const __vector unsigned long long vperm_const
 #define VEC_PERM(vr, va, vb, vc)
 #endif
 
-static unsigned int __attribute__ ((aligned (32)))
-__crc32_vpmsum(unsigned int crc, const void* p, unsigned long len) {
+/*
+ * POWER9 has unaligned vector loads (lxv), so the data doesn't have to be
+ * aligned first. If it needs byteswapping on little endian, lxvb16x loads
+ * it in big endian element order and saves the permute.
+ */
+#if defined(_ARCH_PWR9) && defined(__LITTLE_ENDIAN__) && defined(BYTESWAP_DATA)
+#define VEC_LOAD(vr, off, p) \
+	vr = (__vector unsigned long long)vec_xl_be((off), (unsigned char *)(p))
+#elif defined(_ARCH_PWR9)
+#define VEC_LOAD(vr, off, p) do {					\
+	vr = vec_xl((off), (unsigned long long *)(p));			\
+	VEC_PERM(vr, vr, vr, vperm_const);				\
+} while (0)
+#else
+#define VEC_LOAD(vr, off, p) do {					\
+	vr = vec_ld((off), (__vector unsigned long long *)(p));		\
+	VEC_PERM(vr, vr, vr, vperm_const);				\
+} while (0)
+#endif
 
-	const __vector unsigned long long vzero = {0,0};
-	const __vector unsigned long long vones = {0xffffffffffffffffUL,
-		0xffffffffffffffffUL};
+/*
+ * Bytes 0-15 select the zero vector and bytes 16-31 are 0-15. 16 bytes
+ * loaded at offset n, plus the offset of the data in its quadword, permute
+ * n bytes of that quadword to the least significant end. On POWER9 the
+ * bytes are loaded at offset 0 with lxvl, so nothing is added.
+ */
+static const unsigned char vpartial_const[32]
+	__attribute__ ((aligned(16))) = {
+	16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16,
+	 0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 };
 
-#ifdef REFLECT
-	const __vector unsigned long long vmask_32bit =
-		(__vector unsigned long long)vec_sld((__vector unsigned char)vzero,
-			(__vector unsigned char)vones, 4);
+static __vector unsigned long long __attribute__ ((aligned (32)))
+__crc32_vpmsum(__vector unsigned long long vcrc, const void* p,
+	       unsigned long len);
+
+/*
+ * Append 1-15 bytes to v. We load the aligned quadword that holds them,
+ * so we never touch another page, and permute them to the end of a zeroed
+ * vector. That is a 16 byte chunk we can reduce like the last chunk of a
+ * short buffer. Before POWER9 the bytes must not cross a 16 byte
+ * boundary; on POWER9 lxvl loads exactly len bytes from anywhere.
+ */
+static inline __vector unsigned long long
+crc32_append(__vector unsigned long long v, const unsigned char *p,
+	     unsigned long len)
+{
+	const __vector unsigned char vzero = {0};
+	__vector unsigned char vperm;
+	__vector unsigned long long vdata;
+
+	vperm = vec_xl(len, vpartial_const);
+#ifdef _ARCH_PWR9
+	vdata = (__vector unsigned long long)vec_perm(
+		vec_xl_len((unsigned char *)p, len), vzero, vperm);
+#else
+	vperm = vec_add(vperm,
+		vec_splats((unsigned char)((unsigned long)p & VMX_ALIGN_MASK)));
+
+	vdata = (__vector unsigned long long)vec_perm(vec_ld(0, p), vzero, vperm);
 #endif
+	VEC_PERM(vdata, vdata, vdata, vperm_const);
+
+	vdata = (__vector unsigned long long)__builtin_crypto_vpmsumw(
+		(__vector unsigned int)vdata,
+		(__vector unsigned int)vec_ld(CRC32_ROW * 2 - 16,
+					      vcrc_short_const));
+
+	return vec_xor(crc32_shift(v, len, vcrc_shift_const, CRC32_REFLECTED),
+		       vdata);
+}
+
+#ifndef CRC32_FUNCTION
+#define CRC32_FUNCTION  crc32_vpmsum
+#endif
+
+unsigned int CRC32_FUNCTION(unsigned int crc, const unsigned char *p,
+			    unsigned long len)
+{
+	__vector unsigned long long v, vcrc;
+	unsigned long prealign;
+	unsigned long tail;
+
+#ifdef CRC_XOR
+	crc ^= 0xffffffff;
+#endif
+
+	if (!len)
+		goto out;
+
+	v = crc32_init_sum(crc, CRC32_REFLECTED);
+
+#ifdef _ARCH_PWR9
+	prealign = 0;
+#else
+	prealign = -(unsigned long)p & VMX_ALIGN_MASK;
+#endif
+	if (prealign) {
+		if (prealign > len)
+			prealign = len;
+		v = crc32_append(v, p, prealign);
+		len -= prealign;
+		p += prealign;
+	}
+
+	if (len >= VMX_ALIGN) {
+		/* Carry on from the head, if there was one. */
+		if (prealign)
+			vcrc = crc32_sum_vcrc(v, vcrc_shift_const,
+					      CRC32_REFLECTED);
+		else
+			vcrc = crc32_init_vcrc(crc, CRC32_REFLECTED);
+
+		crc32_prefetch_stream(p, len);
+		v = __crc32_vpmsum(vcrc, p, len & ~VMX_ALIGN_MASK);
+		p += len & ~VMX_ALIGN_MASK;
+	}
+
+	tail = len & VMX_ALIGN_MASK;
+	if (tail)
+		v = crc32_append(v, p, tail);
+
+	crc = crc32_sum_barrett(v, v_Barrett_const, CRC32_REFLECTED);
+
+out:
+#ifdef CRC_XOR
+	crc ^= 0xffffffff;
+#endif
+
+	return crc;
+}
+
+/*
+ * Multiply len bytes at p (under two rows, a multiple of 16) by the short
+ * constants starting at offset, with vcrc xored into the first 16 bytes,
+ * and return the sum of products.
+ *
+ * The vpmsumws don't depend on each other, so rather than xoring every
+ * product into one register we spread them over 4 accumulators, loading
+ * 4 chunks and 4 constants at a time, and combine them at the end.
+ */
+static inline __vector unsigned long long
+crc32_short_sum(__vector unsigned long long vcrc, const void *p,
+		unsigned long len, unsigned int offset)
+{
+	__vector unsigned long long vconst0, vconst1, vconst2, vconst3;
+	__vector unsigned long long vdata0, vdata1, vdata2, vdata3;
+	__vector unsigned long long v0, v1, v2, v3;
+	unsigned long i;
+
+	vconst0 = vec_ld(offset, vcrc_short_const);
+	VEC_LOAD(vdata0, 0, p);
+
+	/* xor initial value */
+	vdata0 = vec_xor(vdata0, vcrc);
+
+	v0 = (__vector unsigned long long)__builtin_crypto_vpmsumw(
+		(__vector unsigned int)vdata0, (__vector unsigned int)vconst0);
+	v1 = v2 = v3 = (__vector unsigned long long){0,0};
+
+	for (i = 16; i + 64 <= len; i += 64) {
+		vconst0 = vec_ld(offset + i, vcrc_short_const);
+		vconst1 = vec_ld(offset + i + 16, vcrc_short_const);
+		vconst2 = vec_ld(offset + i + 32, vcrc_short_const);
+		vconst3 = vec_ld(offset + i + 48, vcrc_short_const);
+
+		VEC_LOAD(vdata0, i, p);
+		VEC_LOAD(vdata1, i + 16, p);
+		VEC_LOAD(vdata2, i + 32, p);
+		VEC_LOAD(vdata3, i + 48, p);
+
+		vdata0 = (__vector unsigned long long)__builtin_crypto_vpmsumw(
+			(__vector unsigned int)vdata0, (__vector unsigned int)vconst0);
+		vdata1 = (__vector unsigned long long)__builtin_crypto_vpmsumw(
+			(__vector unsigned int)vdata1, (__vector unsigned int)vconst1);
+		vdata2 = (__vector unsigned long long)__builtin_crypto_vpmsumw(
+			(__vector unsigned int)vdata2, (__vector unsigned int)vconst2);
+		vdata3 = (__vector unsigned long long)__builtin_crypto_vpmsumw(
+			(__vector unsigned int)vdata3, (__vector unsigned int)vconst3);
+
+		v0 = vec_xor(v0, vdata0);
+		v1 = vec_xor(v1, vdata1);
+		v2 = vec_xor(v2, vdata2);
+		v3 = vec_xor(v3, vdata3);
+	}
+
+	/* Up to 3 chunks are left. */
+	if (i < len) {
+		vconst1 = vec_ld(offset + i, vcrc_short_const);
+		VEC_LOAD(vdata1, i, p);
+		v1 = vec_xor(v1, (__vector unsigned long long)__builtin_crypto_vpmsumw(
+			(__vector unsigned int)vdata1, (__vector unsigned int)vconst1));
+	}
+
+	if (i + 16 < len) {
+		vconst2 = vec_ld(offset + i + 16, vcrc_short_const);
+		VEC_LOAD(vdata2, i + 16, p);
+		v2 = vec_xor(v2, (__vector unsigned long long)__builtin_crypto_vpmsumw(
+			(__vector unsigned int)vdata2, (__vector unsigned int)vconst2));
+	}
+
+	if (i + 32 < len) {
+		vconst3 = vec_ld(offset + i + 32, vcrc_short_const);
+		VEC_LOAD(vdata3, i + 32, p);
+		v3 = vec_xor(v3, (__vector unsigned long long)__builtin_crypto_vpmsumw(
+			(__vector unsigned int)vdata3, (__vector unsigned int)vconst3));
+	}
+
+	v0 = vec_xor(v0, v1);
+	v2 = vec_xor(v2, v3);
 
-	const __vector unsigned long long vmask_64bit =
-		(__vector unsigned long long)vec_sld((__vector unsigned char)vzero,
-			(__vector unsigned char)vones, 8);
+	return vec_xor(v0, v2);
+}
 
-	__vector unsigned long long vcrc;
+#if CRC32_STREAMS == 8
+static __vector unsigned long long __attribute__ ((aligned (32)))
+__crc32_vpmsum(__vector unsigned long long vcrc, const void* p,
+	       unsigned long len) {
+
+	const __vector unsigned long long vzero = {0,0};
 
 	__vector unsigned long long vconst1, vconst2;
 
@@ -182,355 +364,317 @@ __crc32_vpmsum(unsigned int crc, const void* p, unsigned long len) {
 	/* Vector auxiliary variables. */
 	__vector unsigned long long va0, va1, va2, va3, va4, va5, va6, va7;
 
-	unsigned int result = 0;
 	unsigned int offset; /* Constant table offset. */
 
 	unsigned long i; /* Counter. */
 	unsigned long chunks;
 
-	unsigned long block_size;
-	int next_block = 0;
-
 	/* Align by 128 bits. The last 128 bit block will be processed at end. */
 	unsigned long length = len & 0xFFFFFFFFFFFFFF80UL;
 
-#ifdef REFLECT
-	vcrc = (__vector unsigned long long)__builtin_pack_vector(0UL, crc);
-#else
-	vcrc = (__vector unsigned long long)__builtin_pack_vector(crc, 0UL);
-
-	/* Shift into top 32 bits */
-	vcrc = (__vector unsigned long long)vec_sld((__vector unsigned char)vcrc,
-        (__vector unsigned char)vzero, 4);
-#endif
-
 	/* Short version. */
 	if (len < 256) {
-		/* Calculate where in the constant table we need to start. */
-		offset = 256 - len;
+		/* The constants for len bytes start 256 - len into the table. */
+		v0 = crc32_short_sum(vcrc, p, len, 256 - len);
+	} else {
 
-		vconst1 = vec_ld(offset, vcrc_short_const);
-		vdata0 = vec_ld(0, (__vector unsigned long long*) p);
-		VEC_PERM(vdata0, vdata0, vconst1, vperm_const);
+		/* Load initial values. */
+		VEC_LOAD(vdata0, 0, p);
+		VEC_LOAD(vdata1, 16, p);
+		VEC_LOAD(vdata2, 32, p);
+		VEC_LOAD(vdata3, 48, p);
+		VEC_LOAD(vdata4, 64, p);
+		VEC_LOAD(vdata5, 80, p);
+		VEC_LOAD(vdata6, 96, p);
+		VEC_LOAD(vdata7, 112, p);
 
-		/* xor initial value*/
+		/* xor in initial value */
 		vdata0 = vec_xor(vdata0, vcrc);
 
-		vdata0 = (__vector unsigned long long) __builtin_crypto_vpmsumw
-				((__vector unsigned int)vdata0, (__vector unsigned int)vconst1);
-		v0 = vec_xor(v0, vdata0);
+		p = (char *)p + 128;
 
-		for (i = 16; i < len; i += 16) {
-			vconst1 = vec_ld(offset + i, vcrc_short_const);
-			vdata0 = vec_ld(i, (__vector unsigned long long*) p);
-			VEC_PERM(vdata0, vdata0, vconst1, vperm_const);
-			vdata0 = (__vector unsigned long long) __builtin_crypto_vpmsumw
-				((__vector unsigned int)vdata0, (__vector unsigned int)vconst1);
-			v0 = vec_xor(v0, vdata0);
-		}
-	} else {
+		/*
+		 * Anything beyond the last MAX_SIZE block is streamed through the
+		 * 8 parallel chunks, folding them forward 1024 bits every 128
+		 * bytes. This keeps the vpmsum pipeline busy instead of draining
+		 * it at every block boundary.
+		 */
+		if (length > MAX_SIZE) {
+			vconst1 = vec_ld(0, vcrc_fold_const);
+			chunks = (length - MAX_SIZE)/128;
 
-		/* Load initial values. */
-		vdata0 = vec_ld(0, (__vector unsigned long long*) p);
-		vdata1 = vec_ld(16, (__vector unsigned long long*) p);
+			for (i = 0; i < chunks; i++) {
+				CRC32_PREFETCH_LINE(p);
 
-		VEC_PERM(vdata0, vdata0, vdata0, vperm_const);
-		VEC_PERM(vdata1, vdata1, vdata1, vperm_const);
+				va0 = __builtin_crypto_vpmsumd ((__vector unsigned long long)vdata0,
+						(__vector unsigned long long)vconst1);
+				va1 = __builtin_crypto_vpmsumd ((__vector unsigned long long)vdata1,
+						(__vector unsigned long long)vconst1);
+				va2 = __builtin_crypto_vpmsumd ((__vector unsigned long long)vdata2,
+						(__vector unsigned long long)vconst1);
+				va3 = __builtin_crypto_vpmsumd ((__vector unsigned long long)vdata3,
+						(__vector unsigned long long)vconst1);
+				va4 = __builtin_crypto_vpmsumd ((__vector unsigned long long)vdata4,
+						(__vector unsigned long long)vconst1);
+				va5 = __builtin_crypto_vpmsumd ((__vector unsigned long long)vdata5,
+						(__vector unsigned long long)vconst1);
+				va6 = __builtin_crypto_vpmsumd ((__vector unsigned long long)vdata6,
+						(__vector unsigned long long)vconst1);
+				va7 = __builtin_crypto_vpmsumd ((__vector unsigned long long)vdata7,
+						(__vector unsigned long long)vconst1);
 
-		vdata2 = vec_ld(32, (__vector unsigned long long*) p);
-		vdata3 = vec_ld(48, (__vector unsigned long long*) p);
+				VEC_LOAD(vdata0, 0, p);
 
-		VEC_PERM(vdata2, vdata2, vdata2, vperm_const);
-		VEC_PERM(vdata3, vdata3, vdata3, vperm_const);
+				VEC_LOAD(vdata1, 16, p);
 
-		vdata4 = vec_ld(64, (__vector unsigned long long*) p);
-		vdata5 = vec_ld(80, (__vector unsigned long long*) p);
+				VEC_LOAD(vdata2, 32, p);
 
-		VEC_PERM(vdata4, vdata4, vdata4, vperm_const);
-		VEC_PERM(vdata5, vdata5, vdata5, vperm_const);
+				VEC_LOAD(vdata3, 48, p);
 
-		vdata6 = vec_ld(96, (__vector unsigned long long*) p);
-		vdata7 = vec_ld(112, (__vector unsigned long long*) p);
+				VEC_LOAD(vdata4, 64, p);
 
-		VEC_PERM(vdata6, vdata6, vdata6, vperm_const);
-		VEC_PERM(vdata7, vdata7, vdata7, vperm_const);
+				VEC_LOAD(vdata5, 80, p);
 
-		/* xor in initial value */
-		vdata0 = vec_xor(vdata0, vcrc);
+				VEC_LOAD(vdata6, 96, p);
 
-		p = (char *)p + 128;
+				VEC_LOAD(vdata7, 112, p);
+
+				p = (char *)p + 128;
 
-		do {
-			/* Checksum in blocks of MAX_SIZE. */
-			block_size = length;
-			if (block_size > MAX_SIZE) {
-				block_size = MAX_SIZE;
+				vdata0 = vec_xor(vdata0, va0);
+				vdata1 = vec_xor(vdata1, va1);
+				vdata2 = vec_xor(vdata2, va2);
+				vdata3 = vec_xor(vdata3, va3);
+				vdata4 = vec_xor(vdata4, va4);
+				vdata5 = vec_xor(vdata5, va5);
+				vdata6 = vec_xor(vdata6, va6);
+				vdata7 = vec_xor(vdata7, va7);
 			}
 
-			length = length - block_size;
+			/* What is left, including the 1024 bits we carry, is one block. */
+			length = MAX_SIZE;
+		}
 
-			/*
-			* Work out the offset into the constants table to start at. Each
-			* constant is 16 bytes, and it is used against 128 bytes of input
-			* data - 128 / 16 = 8
-			*/
-			offset = (MAX_SIZE/8) - (block_size/8);
-			/* We reduce our final 128 bytes in a separate step */
-			chunks = (block_size/128)-1;
+		/*
+		* Work out the offset into the constants table to start at. Each
+		* constant is 16 bytes, and it is used against 128 bytes of input
+		* data - 128 / 16 = 8
+		*/
+		offset = (MAX_SIZE/8) - (length/8);
+		/* We reduce our final 128 bytes in a separate step */
+		chunks = (length/128)-1;
 
-		    vconst1 = vec_ld(offset, vcrc_const);
+		vconst1 = vec_ld(offset, vcrc_const);
 
-			va0 = __builtin_crypto_vpmsumd ((__vector unsigned long long)vdata0,
-						(__vector unsigned long long)vconst1);
-			va1 = __builtin_crypto_vpmsumd ((__vector unsigned long long)vdata1,
-						(__vector unsigned long long)vconst1);
-			va2 = __builtin_crypto_vpmsumd ((__vector unsigned long long)vdata2,
-						(__vector unsigned long long)vconst1);
-			va3 = __builtin_crypto_vpmsumd ((__vector unsigned long long)vdata3,
-						(__vector unsigned long long)vconst1);
-			va4 = __builtin_crypto_vpmsumd ((__vector unsigned long long)vdata4,
-						(__vector unsigned long long)vconst1);
-			va5 = __builtin_crypto_vpmsumd ((__vector unsigned long long)vdata5,
-						(__vector unsigned long long)vconst1);
-			va6 = __builtin_crypto_vpmsumd ((__vector unsigned long long)vdata6,
-						(__vector unsigned long long)vconst1);
-			va7 = __builtin_crypto_vpmsumd ((__vector unsigned long long)vdata7,
-						(__vector unsigned long long)vconst1);
+		va0 = __builtin_crypto_vpmsumd ((__vector unsigned long long)vdata0,
+					(__vector unsigned long long)vconst1);
+		va1 = __builtin_crypto_vpmsumd ((__vector unsigned long long)vdata1,
+					(__vector unsigned long long)vconst1);
+		va2 = __builtin_crypto_vpmsumd ((__vector unsigned long long)vdata2,
+					(__vector unsigned long long)vconst1);
+		va3 = __builtin_crypto_vpmsumd ((__vector unsigned long long)vdata3,
+					(__vector unsigned long long)vconst1);
+		va4 = __builtin_crypto_vpmsumd ((__vector unsigned long long)vdata4,
+					(__vector unsigned long long)vconst1);
+		va5 = __builtin_crypto_vpmsumd ((__vector unsigned long long)vdata5,
+					(__vector unsigned long long)vconst1);
+		va6 = __builtin_crypto_vpmsumd ((__vector unsigned long long)vdata6,
+					(__vector unsigned long long)vconst1);
+		va7 = __builtin_crypto_vpmsumd ((__vector unsigned long long)vdata7,
+					(__vector unsigned long long)vconst1);
 
-			if (chunks > 1) {
-				offset += 16;
-				vconst2 = vec_ld(offset, vcrc_const);
-				GROUP_ENDING_NOP;
+		if (chunks > 1) {
+			offset += 16;
+			vconst2 = vec_ld(offset, vcrc_const);
+			GROUP_ENDING_NOP;
 
-				vdata0 = vec_ld(0, (__vector unsigned long long*) p);
-				VEC_PERM(vdata0, vdata0, vdata0, vperm_const);
+			VEC_LOAD(vdata0, 0, p);
 
-				vdata1 = vec_ld(16, (__vector unsigned long long*) p);
-				VEC_PERM(vdata1, vdata1, vdata1, vperm_const);
+			VEC_LOAD(vdata1, 16, p);
 
-				vdata2 = vec_ld(32, (__vector unsigned long long*) p);
-				VEC_PERM(vdata2, vdata2, vdata2, vperm_const);
+			VEC_LOAD(vdata2, 32, p);
 
-				vdata3 = vec_ld(48, (__vector unsigned long long*) p);
-				VEC_PERM(vdata3, vdata3, vdata3, vperm_const);
+			VEC_LOAD(vdata3, 48, p);
 
-				vdata4 = vec_ld(64, (__vector unsigned long long*) p);
-				VEC_PERM(vdata4, vdata4, vdata4, vperm_const);
+			VEC_LOAD(vdata4, 64, p);
 
-				vdata5 = vec_ld(80, (__vector unsigned long long*) p);
-				VEC_PERM(vdata5, vdata5, vdata5, vperm_const);
+			VEC_LOAD(vdata5, 80, p);
 
-				vdata6 = vec_ld(96, (__vector unsigned long long*) p);
-				VEC_PERM(vdata6, vdata6, vdata6, vperm_const);
+			VEC_LOAD(vdata6, 96, p);
 
-				vdata7 = vec_ld(112, (__vector unsigned long long*) p);
-				VEC_PERM(vdata7, vdata7, vdata7, vperm_const);
+			VEC_LOAD(vdata7, 112, p);
 
-				p = (char *)p + 128;
+			p = (char *)p + 128;
 
-				/*
-				 * main loop. We modulo schedule it such that it takes three
-				 * iterations to complete - first iteration load, second
-				 * iteration vpmsum, third iteration xor.
-				 */
-				for (i = 0; i < chunks-2; i++) {
-					vconst1 = vec_ld(offset, vcrc_const);
-					offset += 16;
-					GROUP_ENDING_NOP;
-
-					v0 = vec_xor(v0, va0);
-					va0 = __builtin_crypto_vpmsumd ((__vector unsigned long
-							long)vdata0, (__vector unsigned long long)vconst2);
-					vdata0 = vec_ld(0, (__vector unsigned long long*) p);
-					VEC_PERM(vdata0, vdata0, vdata0, vperm_const);
-					GROUP_ENDING_NOP;
-
-					v1 = vec_xor(v1, va1);
-					va1 = __builtin_crypto_vpmsumd ((__vector unsigned long
-							long)vdata1, (__vector unsigned long long)vconst2);
-					vdata1 = vec_ld(16, (__vector unsigned long long*) p);
-					VEC_PERM(vdata1, vdata1, vdata1, vperm_const);
-					GROUP_ENDING_NOP;
-
-					v2 = vec_xor(v2, va2);
-					va2 = __builtin_crypto_vpmsumd ((__vector unsigned long
-							long)vdata2, (__vector unsigned long long)vconst2);
-					vdata2 = vec_ld(32, (__vector unsigned long long*) p);
-					VEC_PERM(vdata2, vdata2, vdata2, vperm_const);
-					GROUP_ENDING_NOP;
-
-					v3 = vec_xor(v3, va3);
-					va3 = __builtin_crypto_vpmsumd ((__vector unsigned long
-							long)vdata3, (__vector unsigned long long)vconst2);
-					vdata3 = vec_ld(48, (__vector unsigned long long*) p);
-					VEC_PERM(vdata3, vdata3, vdata3, vperm_const);
-
-					vconst2 = vec_ld(offset, vcrc_const);
-					GROUP_ENDING_NOP;
-
-					v4 = vec_xor(v4, va4);
-					va4 = __builtin_crypto_vpmsumd ((__vector unsigned long
-							long)vdata4, (__vector unsigned long long)vconst1);
-					vdata4 = vec_ld(64, (__vector unsigned long long*) p);
-					VEC_PERM(vdata4, vdata4, vdata4, vperm_const);
-					GROUP_ENDING_NOP;
-
-					v5 = vec_xor(v5, va5);
-					va5 = __builtin_crypto_vpmsumd ((__vector unsigned long
-							long)vdata5, (__vector unsigned long long)vconst1);
-					vdata5 = vec_ld(80, (__vector unsigned long long*) p);
-					VEC_PERM(vdata5, vdata5, vdata5, vperm_const);
-					GROUP_ENDING_NOP;
-
-					v6 = vec_xor(v6, va6);
-					va6 = __builtin_crypto_vpmsumd ((__vector unsigned long
-							long)vdata6, (__vector unsigned long long)vconst1);
-					vdata6 = vec_ld(96, (__vector unsigned long long*) p);
-					VEC_PERM(vdata6, vdata6, vdata6, vperm_const);
-					GROUP_ENDING_NOP;
-
-					v7 = vec_xor(v7, va7);
-					va7 = __builtin_crypto_vpmsumd ((__vector unsigned long
-							long)vdata7, (__vector unsigned long long)vconst1);
-					vdata7 = vec_ld(112, (__vector unsigned long long*) p);
-					VEC_PERM(vdata7, vdata7, vdata7, vperm_const);
-
-					p = (char *)p + 128;
-				}
-
-				/* First cool down*/
+			/*
+			 * main loop. We modulo schedule it such that it takes three
+			 * iterations to complete - first iteration load, second
+			 * iteration vpmsum, third iteration xor.
+			 */
+			for (i = 0; i < chunks-2; i++) {
 				vconst1 = vec_ld(offset, vcrc_const);
 				offset += 16;
+				CRC32_PREFETCH_LINE(p);
+				GROUP_ENDING_NOP;
 
 				v0 = vec_xor(v0, va0);
 				va0 = __builtin_crypto_vpmsumd ((__vector unsigned long
-							long)vdata0, (__vector unsigned long long)vconst1);
+						long)vdata0, (__vector unsigned long long)vconst2);
+				VEC_LOAD(vdata0, 0, p);
 				GROUP_ENDING_NOP;
 
 				v1 = vec_xor(v1, va1);
 				va1 = __builtin_crypto_vpmsumd ((__vector unsigned long
-							long)vdata1, (__vector unsigned long long)vconst1);
+						long)vdata1, (__vector unsigned long long)vconst2);
+				VEC_LOAD(vdata1, 16, p);
 				GROUP_ENDING_NOP;
 
 				v2 = vec_xor(v2, va2);
 				va2 = __builtin_crypto_vpmsumd ((__vector unsigned long
-							long)vdata2, (__vector unsigned long long)vconst1);
+						long)vdata2, (__vector unsigned long long)vconst2);
+				VEC_LOAD(vdata2, 32, p);
 				GROUP_ENDING_NOP;
 
 				v3 = vec_xor(v3, va3);
 				va3 = __builtin_crypto_vpmsumd ((__vector unsigned long
-							long)vdata3, (__vector unsigned long long)vconst1);
+						long)vdata3, (__vector unsigned long long)vconst2);
+				VEC_LOAD(vdata3, 48, p);
+
+				vconst2 = vec_ld(offset, vcrc_const);
 				GROUP_ENDING_NOP;
 
 				v4 = vec_xor(v4, va4);
 				va4 = __builtin_crypto_vpmsumd ((__vector unsigned long
-							long)vdata4, (__vector unsigned long long)vconst1);
+						long)vdata4, (__vector unsigned long long)vconst1);
+				VEC_LOAD(vdata4, 64, p);
 				GROUP_ENDING_NOP;
 
 				v5 = vec_xor(v5, va5);
 				va5 = __builtin_crypto_vpmsumd ((__vector unsigned long
-							long)vdata5, (__vector unsigned long long)vconst1);
+						long)vdata5, (__vector unsigned long long)vconst1);
+				VEC_LOAD(vdata5, 80, p);
 				GROUP_ENDING_NOP;
 
 				v6 = vec_xor(v6, va6);
 				va6 = __builtin_crypto_vpmsumd ((__vector unsigned long
-							long)vdata6, (__vector unsigned long long)vconst1);
+						long)vdata6, (__vector unsigned long long)vconst1);
+				VEC_LOAD(vdata6, 96, p);
 				GROUP_ENDING_NOP;
 
 				v7 = vec_xor(v7, va7);
 				va7 = __builtin_crypto_vpmsumd ((__vector unsigned long
-							long)vdata7, (__vector unsigned long long)vconst1);
-			}/* else */
+						long)vdata7, (__vector unsigned long long)vconst1);
+				VEC_LOAD(vdata7, 112, p);
+
+				p = (char *)p + 128;
+			}
+
+			/* First cool down*/
+			vconst1 = vec_ld(offset, vcrc_const);
+			offset += 16;
 
-			/* Second cool down. */
 			v0 = vec_xor(v0, va0);
+			va0 = __builtin_crypto_vpmsumd ((__vector unsigned long
+						long)vdata0, (__vector unsigned long long)vconst1);
+			GROUP_ENDING_NOP;
+
 			v1 = vec_xor(v1, va1);
+			va1 = __builtin_crypto_vpmsumd ((__vector unsigned long
+						long)vdata1, (__vector unsigned long long)vconst1);
+			GROUP_ENDING_NOP;
+
 			v2 = vec_xor(v2, va2);
+			va2 = __builtin_crypto_vpmsumd ((__vector unsigned long
+						long)vdata2, (__vector unsigned long long)vconst1);
+			GROUP_ENDING_NOP;
+
 			v3 = vec_xor(v3, va3);
+			va3 = __builtin_crypto_vpmsumd ((__vector unsigned long
+						long)vdata3, (__vector unsigned long long)vconst1);
+			GROUP_ENDING_NOP;
+
 			v4 = vec_xor(v4, va4);
+			va4 = __builtin_crypto_vpmsumd ((__vector unsigned long
+						long)vdata4, (__vector unsigned long long)vconst1);
+			GROUP_ENDING_NOP;
+
 			v5 = vec_xor(v5, va5);
+			va5 = __builtin_crypto_vpmsumd ((__vector unsigned long
+						long)vdata5, (__vector unsigned long long)vconst1);
+			GROUP_ENDING_NOP;
+
 			v6 = vec_xor(v6, va6);
+			va6 = __builtin_crypto_vpmsumd ((__vector unsigned long
+						long)vdata6, (__vector unsigned long long)vconst1);
+			GROUP_ENDING_NOP;
+
 			v7 = vec_xor(v7, va7);
+			va7 = __builtin_crypto_vpmsumd ((__vector unsigned long
+						long)vdata7, (__vector unsigned long long)vconst1);
+		}/* else */
+
+		/* Second cool down. */
+		v0 = vec_xor(v0, va0);
+		v1 = vec_xor(v1, va1);
+		v2 = vec_xor(v2, va2);
+		v3 = vec_xor(v3, va3);
+		v4 = vec_xor(v4, va4);
+		v5 = vec_xor(v5, va5);
+		v6 = vec_xor(v6, va6);
+		v7 = vec_xor(v7, va7);
 
 #ifdef REFLECT
-			/*
-			 * vpmsumd produces a 96 bit result in the least significant bits
-			 * of the register. Since we are bit reflected we have to shift it
-			 * left 32 bits so it occupies the least significant bits in the
-			 * bit reflected domain.
-			 */
-			v0 = (__vector unsigned long long)vec_sld((__vector unsigned char)v0,
-					(__vector unsigned char)vzero, 4);
-			v1 = (__vector unsigned long long)vec_sld((__vector unsigned char)v1,
-					(__vector unsigned char)vzero, 4);
-			v2 = (__vector unsigned long long)vec_sld((__vector unsigned char)v2,
-					(__vector unsigned char)vzero, 4);
-			v3 = (__vector unsigned long long)vec_sld((__vector unsigned char)v3,
-					(__vector unsigned char)vzero, 4);
-			v4 = (__vector unsigned long long)vec_sld((__vector unsigned char)v4,
-					(__vector unsigned char)vzero, 4);
-			v5 = (__vector unsigned long long)vec_sld((__vector unsigned char)v5,
-					(__vector unsigned char)vzero, 4);
-			v6 = (__vector unsigned long long)vec_sld((__vector unsigned char)v6,
-					(__vector unsigned char)vzero, 4);
-			v7 = (__vector unsigned long long)vec_sld((__vector unsigned char)v7,
-					(__vector unsigned char)vzero, 4);
+		/*
+		 * vpmsumd produces a 96 bit result in the least significant bits
+		 * of the register. Since we are bit reflected we have to shift it
+		 * left 32 bits so it occupies the least significant bits in the
+		 * bit reflected domain.
+		 */
+		v0 = (__vector unsigned long long)vec_sld((__vector unsigned char)v0,
+				(__vector unsigned char)vzero, 4);
+		v1 = (__vector unsigned long long)vec_sld((__vector unsigned char)v1,
+				(__vector unsigned char)vzero, 4);
+		v2 = (__vector unsigned long long)vec_sld((__vector unsigned char)v2,
+				(__vector unsigned char)vzero, 4);
+		v3 = (__vector unsigned long long)vec_sld((__vector unsigned char)v3,
+				(__vector unsigned char)vzero, 4);
+		v4 = (__vector unsigned long long)vec_sld((__vector unsigned char)v4,
+				(__vector unsigned char)vzero, 4);
+		v5 = (__vector unsigned long long)vec_sld((__vector unsigned char)v5,
+				(__vector unsigned char)vzero, 4);
+		v6 = (__vector unsigned long long)vec_sld((__vector unsigned char)v6,
+				(__vector unsigned char)vzero, 4);
+		v7 = (__vector unsigned long long)vec_sld((__vector unsigned char)v7,
+				(__vector unsigned char)vzero, 4);
 #endif
 
-			/* xor with the last 1024 bits. */
-			va0 = vec_ld(0, (__vector unsigned long long*) p);
-			VEC_PERM(va0, va0, va0, vperm_const);
+		/* xor with the last 1024 bits. */
+		VEC_LOAD(va0, 0, p);
 
-			va1 = vec_ld(16, (__vector unsigned long long*) p);
-			VEC_PERM(va1, va1, va1, vperm_const);
+		VEC_LOAD(va1, 16, p);
 
-			va2 = vec_ld(32, (__vector unsigned long long*) p);
-			VEC_PERM(va2, va2, va2, vperm_const);
+		VEC_LOAD(va2, 32, p);
 
-			va3 = vec_ld(48, (__vector unsigned long long*) p);
-			VEC_PERM(va3, va3, va3, vperm_const);
+		VEC_LOAD(va3, 48, p);
 
-			va4 = vec_ld(64, (__vector unsigned long long*) p);
-			VEC_PERM(va4, va4, va4, vperm_const);
+		VEC_LOAD(va4, 64, p);
 
-			va5 = vec_ld(80, (__vector unsigned long long*) p);
-			VEC_PERM(va5, va5, va5, vperm_const);
+		VEC_LOAD(va5, 80, p);
 
-			va6 = vec_ld(96, (__vector unsigned long long*) p);
-			VEC_PERM(va6, va6, va6, vperm_const);
+		VEC_LOAD(va6, 96, p);
 
-			va7 = vec_ld(112, (__vector unsigned long long*) p);
-			VEC_PERM(va7, va7, va7, vperm_const);
+		VEC_LOAD(va7, 112, p);
 
-			p = (char *)p + 128;
-
-			vdata0 = vec_xor(v0, va0);
-			vdata1 = vec_xor(v1, va1);
-			vdata2 = vec_xor(v2, va2);
-			vdata3 = vec_xor(v3, va3);
-			vdata4 = vec_xor(v4, va4);
-			vdata5 = vec_xor(v5, va5);
-			vdata6 = vec_xor(v6, va6);
-			vdata7 = vec_xor(v7, va7);
-
-			/* Check if we have more blocks to process */
-			next_block = 0;
-			if (length != 0) {
-				next_block = 1;
-
-			    /* zero v0-v7 */
-				v0 = vec_xor(v0, v0);
-				v1 = vec_xor(v1, v1);
-				v2 = vec_xor(v2, v2);
-				v3 = vec_xor(v3, v3);
-				v4 = vec_xor(v4, v4);
-				v5 = vec_xor(v5, v5);
-				v6 = vec_xor(v6, v6);
-				v7 = vec_xor(v7, v7);
-			}
-			length = length + 128;
+		p = (char *)p + 128;
 
-		} while (next_block);
+		vdata0 = vec_xor(v0, va0);
+		vdata1 = vec_xor(v1, va1);
+		vdata2 = vec_xor(v2, va2);
+		vdata3 = vec_xor(v3, va3);
+		vdata4 = vec_xor(v4, va4);
+		vdata5 = vec_xor(v5, va5);
+		vdata6 = vec_xor(v6, va6);
+		vdata7 = vec_xor(v7, va7);
 
 		/* Calculate how many bytes we have left. */
 		length = (len & 127);
@@ -567,14 +711,8 @@ __crc32_vpmsum(unsigned int crc, const void* p, unsigned long len) {
 			(__vector unsigned int)vdata7,(__vector unsigned int)v7);
 
 		/* Now reduce the tail (0-112 bytes). */
-		for (i = 0; i < length; i+=16) {
-			vdata0 = vec_ld(i,(__vector unsigned long long*)p);
-			VEC_PERM(vdata0, vdata0, vdata0, vperm_const);
-			va0 = vec_ld(offset + i,vcrc_short_const);
-			va0 = (__vector unsigned long long)__builtin_crypto_vpmsumw (
-			(__vector unsigned int)vdata0,(__vector unsigned int)va0);
-			v0 = vec_xor(v0, va0);
-		}
+		if (length)
+			v0 = vec_xor(v0, crc32_short_sum(vzero, p, length, offset));
 
 		/* xor all parallel chunks together. */
 		v0 = vec_xor(v0, v1);
@@ -588,87 +726,149 @@ __crc32_vpmsum(unsigned int crc, const void* p, unsigned long len) {
 		v0 = vec_xor(v0, v4);
 	}
 
-	/* Barrett Reduction */
-	vconst1 = vec_ld(0, v_Barrett_const);
-	vconst2 = vec_ld(16, v_Barrett_const);
+	return v0;
+}
+#else
 
-	v1 = (__vector unsigned long long)vec_sld((__vector unsigned char)v0,
-			(__vector unsigned char)v0, 8);
-	v0 = vec_xor(v1,v0);
+/*
+ * Load a row, one chunk for each stream, and prefetch ahead of it if
+ * CRC32_PREFETCH is set. On POWER10 lxvp loads two chunks at once into a
+ * register pair, which __builtin_vsx_disassemble_pair hands back in
+ * memory order.
+ */
+static inline void crc32_load_row(__vector unsigned long long *vr,
+				  const void *p)
+{
+	int j;
+
+	CRC32_PREFETCH_ROW(p, CRC32_ROW);
+
+#ifdef _ARCH_PWR10
+	__vector_pair vp;
+	__vector unsigned long long vt[2];
+
+	CRC32_UNROLL(CRC32_STREAMS)
+	for (j = 0; j < CRC32_STREAMS; j += 2) {
+		vp = __builtin_vsx_lxvp(j * 16, (__vector_pair *)p);
+		__builtin_vsx_disassemble_pair(vt, &vp);
+		vr[j] = vt[0];
+		vr[j + 1] = vt[1];
+		VEC_PERM(vr[j], vr[j], vr[j], vperm_const);
+		VEC_PERM(vr[j + 1], vr[j + 1], vr[j + 1], vperm_const);
+	}
+#else
+	CRC32_UNROLL(CRC32_STREAMS)
+	for (j = 0; j < CRC32_STREAMS; j++)
+		VEC_LOAD(vr[j], j * 16, p);
+#endif
+}
 
+/*
+ * The same algorithm as the 8 stream kernel for CRC32_STREAMS streams,
+ * written as loops over the streams that the compiler unrolls, so the
+ * streams still live in registers. We leave the scheduling to the
+ * out of order core rather than modulo scheduling by hand.
+ */
+static __vector unsigned long long __attribute__ ((aligned (32)))
+__crc32_vpmsum(__vector unsigned long long vcrc, const void* p,
+	       unsigned long len) {
+
+	const __vector unsigned long long vzero = {0,0};
+	__vector unsigned long long vdata[CRC32_STREAMS];
+	__vector unsigned long long va[CRC32_STREAMS];
+	__vector unsigned long long v[CRC32_STREAMS];
+	__vector unsigned long long vconst;
+	unsigned long length, tail, chunks, i;
+	unsigned int offset;
+	int j;
+
+	/* Short version. */
+	if (len < CRC32_ROW * 2)
+		return crc32_short_sum(vcrc, p, len, CRC32_ROW * 2 - len);
+
+	tail = len % CRC32_ROW;
+	length = len - tail;
+
+	crc32_load_row(vdata, p);
+	p = (char *)p + CRC32_ROW;
+
+	/* xor in initial value */
+	vdata[0] = vec_xor(vdata[0], vcrc);
+
+	/* Stream anything beyond the last block, folding a row at a time. */
+	if (length > CRC32_BLOCK) {
+		vconst = vec_ld(0, vcrc_row_fold_const);
+		chunks = (length - CRC32_BLOCK) / CRC32_ROW;
+
+		for (i = 0; i < chunks; i++) {
+			CRC32_UNROLL(CRC32_STREAMS)
+			for (j = 0; j < CRC32_STREAMS; j++)
+				va[j] = __builtin_crypto_vpmsumd(vdata[j], vconst);
+
+			crc32_load_row(vdata, p);
+			p = (char *)p + CRC32_ROW;
+
+			CRC32_UNROLL(CRC32_STREAMS)
+			for (j = 0; j < CRC32_STREAMS; j++)
+				vdata[j] = vec_xor(vdata[j], va[j]);
+		}
+
+		length = CRC32_BLOCK;
+	}
+
+	/* Each row is multiplied by the constant for its distance to the end. */
+	offset = 16 * ((CRC32_BLOCK - length) / CRC32_ROW);
+	chunks = length / CRC32_ROW - 1;
+
+	CRC32_UNROLL(CRC32_STREAMS)
+	for (j = 0; j < CRC32_STREAMS; j++)
+		v[j] = vzero;
+
+	CRC32_UNROLL(CRC32_ROW_UNROLL)
+	for (i = 0; i < chunks; i++) {
+		vconst = vec_ld(offset, vcrc_const);
+		offset += 16;
+
+		CRC32_UNROLL(CRC32_STREAMS)
+		for (j = 0; j < CRC32_STREAMS; j++)
+			v[j] = vec_xor(v[j],
+				__builtin_crypto_vpmsumd(vdata[j], vconst));
+
+		crc32_load_row(vdata, p);
+		p = (char *)p + CRC32_ROW;
+	}
+
+	/* vdata holds the last row, xor the products into it. */
+	CRC32_UNROLL(CRC32_STREAMS)
+	for (j = 0; j < CRC32_STREAMS; j++) {
 #ifdef REFLECT
-	/* shift left one bit */
-	__vector unsigned char vsht_splat = vec_splat_u8 (1);
-	v0 = (__vector unsigned long long)vec_sll ((__vector unsigned char)v0,
-			vsht_splat);
+		/* Line the 96 bit products up with the data, see above. */
+		v[j] = (__vector unsigned long long)vec_sld(
+			(__vector unsigned char)v[j],
+			(__vector unsigned char)vzero, 4);
 #endif
+		vdata[j] = vec_xor(vdata[j], v[j]);
+	}
 
-	v0 = vec_and(v0, vmask_64bit);
-
-#ifndef REFLECT
-
-	/*
-	 * Now for the actual algorithm. The idea is to calculate q,
-	 * the multiple of our polynomial that we need to subtract. By
-	 * doing the computation 2x bits higher (ie 64 bits) and shifting the
-	 * result back down 2x bits, we round down to the nearest multiple.
-	 */
-
-	/* ma */
-	v1 = __builtin_crypto_vpmsumd ((__vector unsigned long long)v0,
-			(__vector unsigned long long)vconst1);
-	/* q = floor(ma/(2^64)) */
-	v1 = (__vector unsigned long long)vec_sld ((__vector unsigned char)vzero,
-			(__vector unsigned char)v1, 8);
-	/* qn */
-	v1 = __builtin_crypto_vpmsumd ((__vector unsigned long long)v1,
-			(__vector unsigned long long)vconst2);
-	/* a - qn, subtraction is xor in GF(2) */
-	v0 = vec_xor (v0, v1);
-	/*
-	 * Get the result into r3. We need to shift it left 8 bytes:
-	 * V0 [ 0 1 2 X ]
-	 * V0 [ 0 X 2 3 ]
-	 */
-	result = __builtin_unpack_vector_1 (v0);
-#else
+	/* Reduce the last row and the tail with the short constants. */
+	offset = CRC32_ROW - tail;
 
-	/*
-	 * The reflected version of Barrett reduction. Instead of bit
-	 * reflecting our data (which is expensive to do), we bit reflect our
-	 * constants and our algorithm, which means the intermediate data in
-	 * our vector registers goes from 0-63 instead of 63-0. We can reflect
-	 * the algorithm because we don't carry in mod 2 arithmetic.
-	 */
-
-	/* bottom 32 bits of a */
-	v1 = vec_and(v0, vmask_32bit);
-
-	/* ma */
-	v1 = __builtin_crypto_vpmsumd ((__vector unsigned long long)v1,
-			(__vector unsigned long long)vconst1);
-
-	/* bottom 32bits of ma */
-	v1 = vec_and(v1, vmask_32bit);
-	/* qn */
-	v1 = __builtin_crypto_vpmsumd ((__vector unsigned long long)v1,
-			(__vector unsigned long long)vconst2);
-	/* a - qn, subtraction is xor in GF(2) */
-	v0 = vec_xor (v0, v1);
-
-	/*
-	 * Since we are bit reflected, the result (ie the low 32 bits) is in
-	 * the high 32 bits. We just need to shift it left 4 bytes
-	 * V0 [ 0 1 X 3 ]
-	 * V0 [ 0 X 2 3 ]
-	 */
-
-	/* shift result into top 64 bits of */
-	v0 = (__vector unsigned long long)vec_sld((__vector unsigned char)v0,
-        (__vector unsigned char)vzero, 4);
-
-	result = __builtin_unpack_vector_0 (v0);
-#endif
+	CRC32_UNROLL(CRC32_STREAMS)
+	for (j = 0; j < CRC32_STREAMS; j++)
+		v[j] = (__vector unsigned long long)__builtin_crypto_vpmsumw(
+			(__vector unsigned int)vdata[j],
+			(__vector unsigned int)vec_ld(offset + j * 16,
+						      vcrc_short_const));
+
+	offset += CRC32_ROW;
 
-	return result;
+	if (tail)
+		v[0] = vec_xor(v[0], crc32_short_sum(vzero, p, tail, offset));
+
+	CRC32_UNROLL(CRC32_STREAMS)
+	for (j = 1; j < CRC32_STREAMS; j++)
+		v[0] = vec_xor(v[0], v[j]);
+
+	return v[0];
 }
+#endif
@@ -0,0 +1,277 @@
+/*
+ * Calculate the checksums of one buffer with two polynomials, eg CRC-32
+ * and CRC-32C, in a single pass over the data.
+ *
+ * Calling two crc32_vpmsum builds one after the other reads the buffer
+ * twice. Here each 16 byte chunk is loaded (and byteswapped if need be)
+ * once and xored into two sets of 8 accumulators, one per polynomial,
+ * which are folded forward by 1024 bits like vec_crc32_fold.c. That
+ * needs only the 5 fold constants and 2 Barrett constants of each
+ * polynomial. Each set is then folded down and Barrett reduced on its own
+ * with crc32_reduce.h. The head and tail go through each polynomial's
+ * slice by 8 tables.
+ *
+ * Twice the vpmsums per byte means this runs at about half the speed of
+ * a single checksum from L1, but large buffers are only streamed from
+ * memory once.
+ *
+ * The two constants headers come from CRC32_DUAL_HEADER1 and
+ * CRC32_DUAL_HEADER2, by default crc32_ethernet_constants.h (CRC-32) and
+ * crc32_constants.h. Both must be generated with the same -r and -x
+ * options, since the data is loaded once for both.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of either:
+ *
+ *  a) the GNU General Public License as published by the Free Software
+ *     Foundation; either version 2 of the License, or (at your option)
+ *     any later version, or
+ *  b) the Apache License, Version 2.0
+ */
+
+#include <altivec.h>
+
+#define POWER8_FOLD_INTRINSICS
+
+/* Slice by 8 tables for the head and tail */
+#define DUAL_SLICES	8
+#define CRC_SLICE_TABLE	DUAL_SLICES
+
+#ifndef CRC32_DUAL_HEADER1
+#define CRC32_DUAL_HEADER1	"crc32_ethernet_constants.h"
+#endif
+#ifndef CRC32_DUAL_HEADER2
+#define CRC32_DUAL_HEADER2	"crc32_constants.h"
+#endif
+
+/* Include each constants header with its tables renamed. */
+#define crc_slice_table		crc1_slice_table
+#define v_Barrett_const		v1_Barrett_const
+#define vcrc_fold_const		vcrc1_fold_const
+#include CRC32_DUAL_HEADER1
+#undef crc_slice_table
+#undef v_Barrett_const
+#undef vcrc_fold_const
+
+#ifdef REFLECT
+#define CRC1_REFLECT
+#endif
+#ifdef CRC_XOR
+#define CRC1_XOR
+#endif
+#undef CRC
+#undef CRC_XOR
+#undef REFLECT
+#undef MAX_SIZE
+
+#define crc_slice_table		crc2_slice_table
+#define v_Barrett_const		v2_Barrett_const
+#define vcrc_fold_const		vcrc2_fold_const
+#include CRC32_DUAL_HEADER2
+#undef crc_slice_table
+#undef v_Barrett_const
+#undef vcrc_fold_const
+
+#if defined(CRC1_REFLECT) != defined(REFLECT) || \
+	defined(CRC1_XOR) != defined(CRC_XOR)
+#error "Both polynomials must be generated with the same -r and -x options"
+#endif
+
+#define VMX_ALIGN	16
+#define VMX_ALIGN_MASK	(VMX_ALIGN-1)
+
+/* Number of 16 byte streams per polynomial */
+#define DUAL_STREAMS	8
+
+#if defined (__clang__)
+#include "clang_workaround.h"
+#else
+#define __builtin_pack_vector(a, b)  __builtin_pack_vector_int128 ((a), (b))
+#define __builtin_unpack_vector_0(a) __builtin_unpack_vector_int128 ((vector __int128_t)(a), 0)
+#define __builtin_unpack_vector_1(a) __builtin_unpack_vector_int128 ((vector __int128_t)(a), 1)
+#endif
+
+#include "crc32_reduce.h"
+
+/*
+ * We call crc32_slice() with the renamed tables, crc32_align() only knows
+ * crc_slice_table.
+ */
+#undef CRC_SLICE_TABLE
+#include "crc32_slice.h"
+
+#define CRC32_PRAGMA(x)	_Pragma(#x)
+#define CRC32_UNROLL(n)	CRC32_PRAGMA(GCC unroll n)
+
+#if defined(__BIG_ENDIAN__) && defined (REFLECT)
+#define BYTESWAP_DATA
+#elif defined(__LITTLE_ENDIAN__) && !defined(REFLECT)
+#define BYTESWAP_DATA
+#endif
+
+#ifdef BYTESWAP_DATA
+#define VEC_PERM(vr, va, vb, vc) vr = vec_perm(va, vb,\
+			(__vector unsigned char) vc)
+#if defined(__LITTLE_ENDIAN__)
+/* Byte reverse permute constant LE. */
+static const __vector unsigned long long vperm_const
+	__attribute__ ((aligned(16))) = { 0x08090A0B0C0D0E0FUL,
+			0x0001020304050607UL };
+#else
+static const __vector unsigned long long vperm_const
+	__attribute__ ((aligned(16))) = { 0x0F0E0D0C0B0A0908UL,
+			0X0706050403020100UL };
+#endif
+#else
+#define VEC_PERM(vr, va, vb, vc)
+#endif
+
+static void __attribute__ ((aligned (32)))
+__crc32_vpmsum_dual(unsigned int *crc1, unsigned int *crc2, const void *p,
+		    unsigned long len);
+
+/* Checksum the head and tail bytes with one polynomial's tables */
+#define crc32_dual_bytes(crc, table, p, len) \
+	crc32_slice((crc), (p), (len), (table), DUAL_SLICES, CRC32_REFLECTED)
+
+#ifndef CRC32_DUAL_FUNCTION
+#define CRC32_DUAL_FUNCTION	crc32_vpmsum_dual
+#endif
+
+/*
+ * *crc1 and *crc2 hold the initial values on entry, and the checksums of
+ * p with the first and second polynomial on return.
+ */
+void CRC32_DUAL_FUNCTION(unsigned int *crc1, unsigned int *crc2,
+			 const unsigned char *p, unsigned long len)
+{
+	unsigned int c1 = *crc1, c2 = *crc2;
+	unsigned int prealign;
+	unsigned int tail;
+
+#ifdef CRC_XOR
+	c1 ^= 0xffffffff;
+	c2 ^= 0xffffffff;
+#endif
+
+	if (len < VMX_ALIGN + VMX_ALIGN_MASK) {
+		c1 = crc32_dual_bytes(c1, crc1_slice_table, p, len);
+		c2 = crc32_dual_bytes(c2, crc2_slice_table, p, len);
+		goto out;
+	}
+
+	if ((unsigned long)p & VMX_ALIGN_MASK) {
+		prealign = VMX_ALIGN - ((unsigned long)p & VMX_ALIGN_MASK);
+		c1 = crc32_dual_bytes(c1, crc1_slice_table, p, prealign);
+		c2 = crc32_dual_bytes(c2, crc2_slice_table, p, prealign);
+		len -= prealign;
+		p += prealign;
+	}
+
+	__crc32_vpmsum_dual(&c1, &c2, p, len & ~VMX_ALIGN_MASK);
+
+	tail = len & VMX_ALIGN_MASK;
+	if (tail) {
+		p += len & ~VMX_ALIGN_MASK;
+		c1 = crc32_dual_bytes(c1, crc1_slice_table, p, tail);
+		c2 = crc32_dual_bytes(c2, crc2_slice_table, p, tail);
+	}
+
+out:
+#ifdef CRC_XOR
+	c1 ^= 0xffffffff;
+	c2 ^= 0xffffffff;
+#endif
+
+	*crc1 = c1;
+	*crc2 = c2;
+}
+
+/*
+ * Checksum len bytes at p, 16 byte aligned and a multiple of 16 bytes,
+ * with both polynomials.
+ */
+static void __attribute__ ((aligned (32)))
+__crc32_vpmsum_dual(unsigned int *crc1, unsigned int *crc2, const void *p,
+		    unsigned long len) {
+
+	const __vector unsigned long long vfold1_1024 = vec_ld(0, vcrc1_fold_const);
+	const __vector unsigned long long vfold2_1024 = vec_ld(0, vcrc2_fold_const);
+	const __vector unsigned long long vfold1_128 = vec_ld(48, vcrc1_fold_const);
+	const __vector unsigned long long vfold2_128 = vec_ld(48, vcrc2_fold_const);
+
+	/* a holds the checksums for the first polynomial, b the second. */
+	__vector unsigned long long a[DUAL_STREAMS], b[DUAL_STREAMS];
+	__vector unsigned long long vdata, va0, vb0;
+	int j;
+
+	if (len == 0)
+		return;
+
+	if (len >= 128) {
+		CRC32_UNROLL(8)
+		for (j = 0; j < DUAL_STREAMS; j++) {
+			vdata = vec_ld(j * 16, (__vector unsigned long long *)p);
+			VEC_PERM(vdata, vdata, vdata, vperm_const);
+			a[j] = b[j] = vdata;
+		}
+
+		/* xor in initial values */
+		a[0] = vec_xor(a[0], crc32_init_vcrc(*crc1, CRC32_REFLECTED));
+		b[0] = vec_xor(b[0], crc32_init_vcrc(*crc2, CRC32_REFLECTED));
+
+		p = (char *)p + 128;
+		len -= 128;
+
+		/*
+		 * main loop. Every 128 bytes we fold each chunk of both sets
+		 * forward by 1024 bits and xor in the next 16 bytes of its
+		 * stream, loaded once for both.
+		 */
+		while (len >= 128) {
+			CRC32_UNROLL(8)
+			for (j = 0; j < DUAL_STREAMS; j++) {
+				vdata = vec_ld(j * 16, (__vector unsigned long long *)p);
+				VEC_PERM(vdata, vdata, vdata, vperm_const);
+
+				a[j] = vec_xor(vdata,
+					__builtin_crypto_vpmsumd(a[j], vfold1_1024));
+				b[j] = vec_xor(vdata,
+					__builtin_crypto_vpmsumd(b[j], vfold2_1024));
+			}
+
+			p = (char *)p + 128;
+			len -= 128;
+		}
+
+		va0 = crc32_fold_streams(a, vcrc1_fold_const);
+		vb0 = crc32_fold_streams(b, vcrc2_fold_const);
+	} else {
+		vdata = vec_ld(0, (__vector unsigned long long *)p);
+		VEC_PERM(vdata, vdata, vdata, vperm_const);
+
+		/* xor in initial values */
+		va0 = vec_xor(vdata, crc32_init_vcrc(*crc1, CRC32_REFLECTED));
+		vb0 = vec_xor(vdata, crc32_init_vcrc(*crc2, CRC32_REFLECTED));
+
+		p = (char *)p + 16;
+		len -= 16;
+	}
+
+	/* Now fold in the tail (0-112 bytes), 16 bytes at a time. */
+	while (len) {
+		vdata = vec_ld(0, (__vector unsigned long long *)p);
+		VEC_PERM(vdata, vdata, vdata, vperm_const);
+
+		va0 = vec_xor(vdata, __builtin_crypto_vpmsumd(va0, vfold1_128));
+		vb0 = vec_xor(vdata, __builtin_crypto_vpmsumd(vb0, vfold2_128));
+
+		p = (char *)p + 16;
+		len -= 16;
+	}
+
+	*crc1 = crc32_reduce(va0, vcrc1_fold_const, v1_Barrett_const,
+			     CRC32_REFLECTED);
+	*crc2 = crc32_reduce(vb0, vcrc2_fold_const, v2_Barrett_const,
+			     CRC32_REFLECTED);
+}
@@ -0,0 +1,359 @@
+/*
+ * Calculate the checksum of data that is 16 byte aligned and a multiple of
+ * 16 bytes, folding by a fixed distance.
+ *
+ * Like vec_crc32.c we checksum in 8 parallel chunks in order to mask the
+ * latency of the vpmsum instructions. Instead of multiplying each 128 bytes
+ * by a constant for its distance from the end of a 32 kB block, we fold
+ * the 8 chunks forward by 1024 bits on every iteration. This needs one
+ * constant instead of the 4 kB vcrc_const table, so nothing is loaded in
+ * the main loop and the whole kernel runs from a handful of constants kept
+ * in registers.
+ *
+ * Once the data is consumed we fold the 8 chunks together (by 512, 256
+ * and 128 bits), fold in any remaining 16 byte chunks one at a time and
+ * reduce the final 128 bits to 64 bits. This step adds 32 bits of 0s to
+ * the end - this matches what a CRC does.
+ *
+ * We then use fixed point Barrett reduction to compute a mod n over GF(2)
+ * for n = CRC using POWER8 instructions. We use x = 32. The fold of the 8
+ * chunks and both reductions are in crc32_reduce.h, shared with the other
+ * kernels that use these constants.
+ *
+ * http://en.wikipedia.org/wiki/Barrett_reduction
+ *
+ * Built with -D CRC32_HYBRID, buffers of CRC32_HYBRID_MIN bytes or more
+ * are split in two: the vector loop checksums the front while slice by 8
+ * table lookups checksum the back, CRC32_HYBRID_BYTES per 128 vector
+ * bytes. The lookups run on the fixed point and load/store units, which
+ * are otherwise idle while we wait on vpmsum. crc32_combine() then
+ * shifts the CRC of the front past the back and xors in the CRC of the
+ * back, so link with crc32_combine.o.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of either:
+ *
+ *  a) the GNU General Public License as published by the Free Software
+ *     Foundation; either version 2 of the License, or (at your option)
+ *     any later version, or
+ *  b) the Apache License, Version 2.0
+ */
+
+#include <altivec.h>
+
+#define POWER8_FOLD_INTRINSICS
+#define CRC_SLICE_TABLE 8
+
+#ifdef CRC32_CONSTANTS_HEADER
+#include CRC32_CONSTANTS_HEADER
+#else
+#include "crc32_constants.h"
+#endif
+
+#define VMX_ALIGN	16
+#define VMX_ALIGN_MASK	(VMX_ALIGN-1)
+
+#include "crc32_slice.h"
+
+#ifdef CRC32_HYBRID
+/* Bytes of table lookups per 128 vector bytes, a multiple of 8 */
+#ifndef CRC32_HYBRID_BYTES
+#define CRC32_HYBRID_BYTES	16
+#endif
+
+/* Not worth a crc32_combine() below this */
+#ifndef CRC32_HYBRID_MIN
+#define CRC32_HYBRID_MIN	4096
+#endif
+
+#ifndef CRC32_COMBINE_FUNCTION
+#define CRC32_COMBINE_FUNCTION	crc32_combine
+#endif
+
+unsigned int CRC32_COMBINE_FUNCTION(unsigned int crc1, unsigned int crc2,
+				    unsigned long len2);
+
+/*
+ * Also checksum CRC32_HYBRID_BYTES at q into *qcrc for every 128 bytes
+ * the main loop consumes after the first, unless q is NULL.
+ */
+static unsigned int __attribute__ ((aligned (32)))
+__crc32_vpmsum(unsigned int crc, const void* p, unsigned long len,
+	       const unsigned char *q, unsigned int *qcrc);
+#else
+static unsigned int __attribute__ ((aligned (32)))
+__crc32_vpmsum(unsigned int crc, const void* p, unsigned long len);
+#endif
+
+#ifndef CRC32_FUNCTION
+#define CRC32_FUNCTION  crc32_vpmsum
+#endif
+
+unsigned int CRC32_FUNCTION(unsigned int crc, const unsigned char *p,
+			    unsigned long len)
+{
+	unsigned int prealign;
+	unsigned int tail;
+#ifdef CRC32_HYBRID
+	unsigned long vlen, slen, done;
+	unsigned int scrc = 0;
+#endif
+
+#ifdef CRC_XOR
+	crc ^= 0xffffffff;
+#endif
+
+	if (len < VMX_ALIGN + VMX_ALIGN_MASK) {
+		crc = crc32_align(crc, p, len);
+		goto out;
+	}
+
+	if ((unsigned long)p & VMX_ALIGN_MASK) {
+		prealign = VMX_ALIGN - ((unsigned long)p & VMX_ALIGN_MASK);
+		crc = crc32_align(crc, p, prealign);
+		len -= prealign;
+		p += prealign;
+	}
+
+#ifdef CRC32_HYBRID
+	if ((len & ~VMX_ALIGN_MASK) >= CRC32_HYBRID_MIN) {
+		/* Split so both parts take about the same number of iterations */
+		vlen = (len & ~VMX_ALIGN_MASK) / (128 + CRC32_HYBRID_BYTES) * 128;
+		slen = (len & ~VMX_ALIGN_MASK) - vlen;
+		done = (vlen / 128 - 1) * CRC32_HYBRID_BYTES;
+
+		crc = __crc32_vpmsum(crc, p, vlen, p + vlen, &scrc);
+		scrc = crc32_align(scrc, p + vlen + done, slen - done);
+		crc = CRC32_COMBINE_FUNCTION(crc, scrc, slen);
+	} else {
+		crc = __crc32_vpmsum(crc, p, len & ~VMX_ALIGN_MASK, NULL, NULL);
+	}
+#else
+	crc = __crc32_vpmsum(crc, p, len & ~VMX_ALIGN_MASK);
+#endif
+
+	tail = len & VMX_ALIGN_MASK;
+	if (tail) {
+		p += len & ~VMX_ALIGN_MASK;
+		crc = crc32_align(crc, p, tail);
+	}
+
+out:
+#ifdef CRC_XOR
+	crc ^= 0xffffffff;
+#endif
+
+	return crc;
+}
+
+#if defined (__clang__)
+#include "clang_workaround.h"
+#else
+#define __builtin_pack_vector(a, b)  __builtin_pack_vector_int128 ((a), (b))
+#define __builtin_unpack_vector_0(a) __builtin_unpack_vector_int128 ((vector __int128_t)(a), 0)
+#define __builtin_unpack_vector_1(a) __builtin_unpack_vector_int128 ((vector __int128_t)(a), 1)
+#endif
+
+#include "crc32_reduce.h"
+
+#if defined(__BIG_ENDIAN__) && defined (REFLECT)
+#define BYTESWAP_DATA
+#elif defined(__LITTLE_ENDIAN__) && !defined(REFLECT)
+#define BYTESWAP_DATA
+#endif
+
+#ifdef BYTESWAP_DATA
+#define VEC_PERM(vr, va, vb, vc) vr = vec_perm(va, vb,\
+			(__vector unsigned char) vc)
+#if defined(__LITTLE_ENDIAN__)
+/* Byte reverse permute constant LE. */
+static const __vector unsigned long long vperm_const
+	__attribute__ ((aligned(16))) = { 0x08090A0B0C0D0E0FUL,
+			0x0001020304050607UL };
+#else
+static const __vector unsigned long long vperm_const
+	__attribute__ ((aligned(16))) = { 0x0F0E0D0C0B0A0908UL,
+			0X0706050403020100UL };
+#endif
+#else
+#define VEC_PERM(vr, va, vb, vc)
+#endif
+
+#ifdef CRC32_HYBRID
+static unsigned int __attribute__ ((aligned (32)))
+__crc32_vpmsum(unsigned int crc, const void* p, unsigned long len,
+	       const unsigned char *q, unsigned int *qcrc) {
+#else
+static unsigned int __attribute__ ((aligned (32)))
+__crc32_vpmsum(unsigned int crc, const void* p, unsigned long len) {
+#endif
+
+	/*
+	 * Fold by 1024 and 128 bits here, the rest is in crc32_fold_streams()
+	 * and crc32_reduce().
+	 */
+	const __vector unsigned long long vfold1024 = vec_ld(0, vcrc_fold_const);
+	const __vector unsigned long long vfold128 = vec_ld(48, vcrc_fold_const);
+
+	__vector unsigned long long vcrc;
+
+	/* vdata0-vdata7 will contain our checksums */
+	__vector unsigned long long vdata0, vdata1, vdata2, vdata3, vdata4,
+		vdata5, vdata6, vdata7;
+
+	/* Vector auxiliary variables. */
+	__vector unsigned long long va0, va1, va2, va3, va4, va5, va6, va7;
+
+	__vector unsigned long long v[8];
+
+#ifdef CRC32_HYBRID
+	/* Keep the table CRC in a register, not behind the pointer */
+	unsigned int qc = q ? *qcrc : 0;
+#endif
+
+	if (len == 0)
+		return crc;
+
+	vcrc = crc32_init_vcrc(crc, CRC32_REFLECTED);
+
+	if (len >= 128) {
+		vdata0 = vec_ld(0, (__vector unsigned long long*) p);
+		VEC_PERM(vdata0, vdata0, vdata0, vperm_const);
+
+		vdata1 = vec_ld(16, (__vector unsigned long long*) p);
+		VEC_PERM(vdata1, vdata1, vdata1, vperm_const);
+
+		vdata2 = vec_ld(32, (__vector unsigned long long*) p);
+		VEC_PERM(vdata2, vdata2, vdata2, vperm_const);
+
+		vdata3 = vec_ld(48, (__vector unsigned long long*) p);
+		VEC_PERM(vdata3, vdata3, vdata3, vperm_const);
+
+		vdata4 = vec_ld(64, (__vector unsigned long long*) p);
+		VEC_PERM(vdata4, vdata4, vdata4, vperm_const);
+
+		vdata5 = vec_ld(80, (__vector unsigned long long*) p);
+		VEC_PERM(vdata5, vdata5, vdata5, vperm_const);
+
+		vdata6 = vec_ld(96, (__vector unsigned long long*) p);
+		VEC_PERM(vdata6, vdata6, vdata6, vperm_const);
+
+		vdata7 = vec_ld(112, (__vector unsigned long long*) p);
+		VEC_PERM(vdata7, vdata7, vdata7, vperm_const);
+
+		/* xor in initial value */
+		vdata0 = vec_xor(vdata0, vcrc);
+
+		p = (char *)p + 128;
+		len -= 128;
+
+		/*
+		 * main loop. Every 128 bytes we fold each chunk forward by 1024
+		 * bits and xor in the next 16 bytes of its stream.
+		 */
+		while (len >= 128) {
+			va0 = __builtin_crypto_vpmsumd ((__vector unsigned long long)vdata0,
+					(__vector unsigned long long)vfold1024);
+			va1 = __builtin_crypto_vpmsumd ((__vector unsigned long long)vdata1,
+					(__vector unsigned long long)vfold1024);
+			va2 = __builtin_crypto_vpmsumd ((__vector unsigned long long)vdata2,
+					(__vector unsigned long long)vfold1024);
+			va3 = __builtin_crypto_vpmsumd ((__vector unsigned long long)vdata3,
+					(__vector unsigned long long)vfold1024);
+			va4 = __builtin_crypto_vpmsumd ((__vector unsigned long long)vdata4,
+					(__vector unsigned long long)vfold1024);
+			va5 = __builtin_crypto_vpmsumd ((__vector unsigned long long)vdata5,
+					(__vector unsigned long long)vfold1024);
+			va6 = __builtin_crypto_vpmsumd ((__vector unsigned long long)vdata6,
+					(__vector unsigned long long)vfold1024);
+			va7 = __builtin_crypto_vpmsumd ((__vector unsigned long long)vdata7,
+					(__vector unsigned long long)vfold1024);
+
+			vdata0 = vec_ld(0, (__vector unsigned long long*) p);
+			VEC_PERM(vdata0, vdata0, vdata0, vperm_const);
+
+			vdata1 = vec_ld(16, (__vector unsigned long long*) p);
+			VEC_PERM(vdata1, vdata1, vdata1, vperm_const);
+
+			vdata2 = vec_ld(32, (__vector unsigned long long*) p);
+			VEC_PERM(vdata2, vdata2, vdata2, vperm_const);
+
+			vdata3 = vec_ld(48, (__vector unsigned long long*) p);
+			VEC_PERM(vdata3, vdata3, vdata3, vperm_const);
+
+			vdata4 = vec_ld(64, (__vector unsigned long long*) p);
+			VEC_PERM(vdata4, vdata4, vdata4, vperm_const);
+
+			vdata5 = vec_ld(80, (__vector unsigned long long*) p);
+			VEC_PERM(vdata5, vdata5, vdata5, vperm_const);
+
+			vdata6 = vec_ld(96, (__vector unsigned long long*) p);
+			VEC_PERM(vdata6, vdata6, vdata6, vperm_const);
+
+			vdata7 = vec_ld(112, (__vector unsigned long long*) p);
+			VEC_PERM(vdata7, vdata7, vdata7, vperm_const);
+
+			p = (char *)p + 128;
+			len -= 128;
+
+#ifdef CRC32_HYBRID
+			if (q) {
+				qc = crc32_align(qc, q, CRC32_HYBRID_BYTES);
+				q += CRC32_HYBRID_BYTES;
+			}
+#endif
+
+			vdata0 = vec_xor(vdata0, va0);
+			vdata1 = vec_xor(vdata1, va1);
+			vdata2 = vec_xor(vdata2, va2);
+			vdata3 = vec_xor(vdata3, va3);
+			vdata4 = vec_xor(vdata4, va4);
+			vdata5 = vec_xor(vdata5, va5);
+			vdata6 = vec_xor(vdata6, va6);
+			vdata7 = vec_xor(vdata7, va7);
+		}
+
+		/* Fold the 8 chunks into one: by 512, then 256, then 128 bits. */
+		v[0] = vdata0;
+		v[1] = vdata1;
+		v[2] = vdata2;
+		v[3] = vdata3;
+		v[4] = vdata4;
+		v[5] = vdata5;
+		v[6] = vdata6;
+		v[7] = vdata7;
+
+		vdata0 = crc32_fold_streams(v, vcrc_fold_const);
+
+#ifdef CRC32_HYBRID
+		if (q)
+			*qcrc = qc;
+#endif
+	} else {
+		vdata0 = vec_ld(0, (__vector unsigned long long*) p);
+		VEC_PERM(vdata0, vdata0, vdata0, vperm_const);
+
+		/* xor in initial value */
+		vdata0 = vec_xor(vdata0, vcrc);
+
+		p = (char *)p + 16;
+		len -= 16;
+	}
+
+	/* Now fold in the tail (0-112 bytes), 16 bytes at a time. */
+	while (len) {
+		va0 = __builtin_crypto_vpmsumd ((__vector unsigned long long)vdata0,
+				(__vector unsigned long long)vfold128);
+
+		vdata0 = vec_ld(0, (__vector unsigned long long*) p);
+		VEC_PERM(vdata0, vdata0, vdata0, vperm_const);
+
+		vdata0 = vec_xor(vdata0, va0);
+
+		p = (char *)p + 16;
+		len -= 16;
+	}
+
+	return crc32_reduce(vdata0, vcrc_fold_const, v_Barrett_const,
+			    CRC32_REFLECTED);
+}
@@ -0,0 +1,345 @@
+/*
+ * Calculate the checksums of many independent buffers of the same length.
+ *
+ * A single small buffer can't hide the latency of vpmsum: the fold of
+ * each 16 bytes depends on the fold before it, and the final reduction is
+ * a serial chain of multiplies. Instead we checksum 4 buffers at once,
+ * each split into 2 interleaved streams folded forward by 256 bits. That
+ * gives 8 independent vpmsum chains, the same as the large buffer kernel,
+ * and the 4 final reductions are independent of each other too.
+ *
+ * The buffers don't have to be aligned, we load them with vec_xl. Any
+ * trailing bytes that don't make up a 16 byte chunk are done with the
+ * table, one buffer at a time.
+ *
+ * crc32_vpmsum_verify() uses this to check the segments of one buffer
+ * (eg every 4 kB) against their stored CRCs in a single pass, 4 adjacent
+ * segments at a time.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of either:
+ *
+ *  a) the GNU General Public License as published by the Free Software
+ *     Foundation; either version 2 of the License, or (at your option)
+ *     any later version, or
+ *  b) the Apache License, Version 2.0
+ */
+
+#include <altivec.h>
+
+#define POWER8_FOLD_INTRINSICS
+#define CRC_SLICE_TABLE 8
+
+#ifdef CRC32_CONSTANTS_HEADER
+#include CRC32_CONSTANTS_HEADER
+#else
+#include "crc32_constants.h"
+#endif
+
+#define VMX_ALIGN	16
+#define VMX_ALIGN_MASK	(VMX_ALIGN-1)
+
+/* Number of buffers checksummed together */
+#define MULTI_WAYS	4
+
+#include "crc32_slice.h"
+#include "crc32_multi.h"
+
+static void __attribute__ ((aligned (32)))
+__crc32_vpmsum_multi(unsigned int *crc, const unsigned char **p,
+		     unsigned long len);
+
+#ifndef CRC32_MULTI_FUNCTION
+#define CRC32_MULTI_FUNCTION  crc32_vpmsum_multi
+#endif
+#ifndef CRC32_VERIFY_FUNCTION
+#define CRC32_VERIFY_FUNCTION crc32_vpmsum_verify
+#endif
+
+/*
+ * Checksum n buffers of len bytes each. crcs[i] holds the initial value
+ * for ptrs[i] on entry and its checksum on return.
+ */
+void CRC32_MULTI_FUNCTION(unsigned int *crcs, const unsigned char **ptrs,
+			  unsigned long len, unsigned int n)
+{
+	unsigned int crc[MULTI_WAYS];
+	const unsigned char *p[MULTI_WAYS];
+	unsigned long tail = len & VMX_ALIGN_MASK;
+	unsigned int i, j, ways;
+
+	for (i = 0; i < n; i += ways) {
+		ways = n - i;
+		if (ways > MULTI_WAYS)
+			ways = MULTI_WAYS;
+
+		/* Unused lanes repeat the first buffer, their result is dropped */
+		for (j = 0; j < MULTI_WAYS; j++) {
+			crc[j] = crcs[i + (j < ways ? j : 0)];
+			p[j] = ptrs[i + (j < ways ? j : 0)];
+#ifdef CRC_XOR
+			crc[j] ^= 0xffffffff;
+#endif
+		}
+
+		if (len < 2 * VMX_ALIGN) {
+			for (j = 0; j < ways; j++)
+				crc[j] = crc32_align(crc[j], p[j], len);
+		} else {
+			__crc32_vpmsum_multi(crc, p, len & ~VMX_ALIGN_MASK);
+
+			if (tail) {
+				for (j = 0; j < ways; j++)
+					crc[j] = crc32_align(crc[j],
+						p[j] + (len & ~VMX_ALIGN_MASK), tail);
+			}
+		}
+
+		for (j = 0; j < ways; j++) {
+#ifdef CRC_XOR
+			crc[j] ^= 0xffffffff;
+#endif
+			crcs[i + j] = crc[j];
+		}
+	}
+}
+
+/*
+ * Check each seg byte segment of p against expected[], the CRC of that
+ * segment with an initial value of 0. A last segment shorter than seg is
+ * checked too. Bit i of bad[] is set if segment i doesn't match, and the
+ * number of mismatches is returned. bad may be NULL if only the count is
+ * needed.
+ *
+ * With CRC32_VERIFY_STOP we return as soon as a group of segments checked
+ * together has a mismatch, so corrupt data isn't read to the end. Bits for
+ * the segments after that group are left clear.
+ */
+unsigned long CRC32_VERIFY_FUNCTION(const unsigned char *p, unsigned long len,
+				    unsigned long seg,
+				    const unsigned int *expected,
+				    unsigned long *bad, unsigned int flags)
+{
+	const unsigned char *ptrs[MULTI_WAYS];
+	unsigned int crcs[MULTI_WAYS];
+	unsigned long nseg, total, i, nbad = 0;
+	unsigned int j, ways;
+
+	if (!seg)
+		return 0;
+
+	nseg = len / seg;
+	total = nseg + (len % seg != 0);
+
+	if (bad) {
+		for (i = 0; i < (total + CRC32_VERIFY_BITS - 1) /
+				CRC32_VERIFY_BITS; i++)
+			bad[i] = 0;
+	}
+
+	for (i = 0; i < total; i += ways) {
+		if (i < nseg) {
+			ways = nseg - i;
+			if (ways > MULTI_WAYS)
+				ways = MULTI_WAYS;
+		} else {
+			/* The short last segment */
+			ways = 1;
+		}
+
+		for (j = 0; j < ways; j++) {
+			ptrs[j] = p + (i + j) * seg;
+			crcs[j] = 0;
+		}
+
+		CRC32_MULTI_FUNCTION(crcs, ptrs, i < nseg ? seg : len % seg,
+				     ways);
+
+		for (j = 0; j < ways; j++) {
+			if (crcs[j] == expected[i + j])
+				continue;
+
+			if (bad)
+				bad[(i + j) / CRC32_VERIFY_BITS] |=
+					1UL << ((i + j) % CRC32_VERIFY_BITS);
+			nbad++;
+		}
+
+		if (nbad && (flags & CRC32_VERIFY_STOP))
+			break;
+	}
+
+	return nbad;
+}
+
+#if defined (__clang__)
+#include "clang_workaround.h"
+#else
+#define __builtin_pack_vector(a, b)  __builtin_pack_vector_int128 ((a), (b))
+#define __builtin_unpack_vector_0(a) __builtin_unpack_vector_int128 ((vector __int128_t)(a), 0)
+#define __builtin_unpack_vector_1(a) __builtin_unpack_vector_int128 ((vector __int128_t)(a), 1)
+#endif
+
+#include "crc32_reduce.h"
+
+#if defined(__BIG_ENDIAN__) && defined (REFLECT)
+#define BYTESWAP_DATA
+#elif defined(__LITTLE_ENDIAN__) && !defined(REFLECT)
+#define BYTESWAP_DATA
+#endif
+
+#ifdef BYTESWAP_DATA
+#define VEC_PERM(vr, va, vb, vc) vr = vec_perm(va, vb,\
+			(__vector unsigned char) vc)
+#if defined(__LITTLE_ENDIAN__)
+/* Byte reverse permute constant LE. */
+static const __vector unsigned long long vperm_const
+	__attribute__ ((aligned(16))) = { 0x08090A0B0C0D0E0FUL,
+			0x0001020304050607UL };
+#else
+static const __vector unsigned long long vperm_const
+	__attribute__ ((aligned(16))) = { 0x0F0E0D0C0B0A0908UL,
+			0X0706050403020100UL };
+#endif
+#else
+#define VEC_PERM(vr, va, vb, vc)
+#endif
+
+#define VEC_LOAD(vr, off, p) do {					\
+	vr = vec_xl((off), (unsigned long long *)(p));			\
+	VEC_PERM(vr, vr, vr, vperm_const);				\
+} while (0)
+
+/*
+ * Checksum MULTI_WAYS buffers. len is a multiple of 16 and at least 32.
+ * Buffer j is folded in vdata(2j) and vdata(2j+1), even and odd 16 byte
+ * chunks respectively.
+ */
+static void __attribute__ ((aligned (32)))
+__crc32_vpmsum_multi(unsigned int *crc, const unsigned char **p,
+		     unsigned long len)
+{
+	/* Fold by 256 and 128 bits, then reduce 128 bits. */
+	const __vector unsigned long long vfold256 = vec_ld(32, vcrc_fold_const);
+	const __vector unsigned long long vfold128 = vec_ld(48, vcrc_fold_const);
+
+	const unsigned char *p0 = p[0], *p1 = p[1], *p2 = p[2], *p3 = p[3];
+
+	__vector unsigned long long vcrc0, vcrc1, vcrc2, vcrc3;
+
+	/* vdata0-vdata7 will contain our checksums */
+	__vector unsigned long long vdata0, vdata1, vdata2, vdata3, vdata4,
+		vdata5, vdata6, vdata7;
+
+	/* Vector auxiliary variables. */
+	__vector unsigned long long va0, va1, va2, va3, va4, va5, va6, va7;
+
+	unsigned long i;
+
+	vcrc0 = crc32_init_vcrc(crc[0], CRC32_REFLECTED);
+	vcrc1 = crc32_init_vcrc(crc[1], CRC32_REFLECTED);
+	vcrc2 = crc32_init_vcrc(crc[2], CRC32_REFLECTED);
+	vcrc3 = crc32_init_vcrc(crc[3], CRC32_REFLECTED);
+
+	VEC_LOAD(vdata0, 0, p0);
+	VEC_LOAD(vdata1, 16, p0);
+	VEC_LOAD(vdata2, 0, p1);
+	VEC_LOAD(vdata3, 16, p1);
+	VEC_LOAD(vdata4, 0, p2);
+	VEC_LOAD(vdata5, 16, p2);
+	VEC_LOAD(vdata6, 0, p3);
+	VEC_LOAD(vdata7, 16, p3);
+
+	/* xor in initial values */
+	vdata0 = vec_xor(vdata0, vcrc0);
+	vdata2 = vec_xor(vdata2, vcrc1);
+	vdata4 = vec_xor(vdata4, vcrc2);
+	vdata6 = vec_xor(vdata6, vcrc3);
+
+	/*
+	 * main loop. Every 32 bytes we fold each stream forward by 256 bits
+	 * and xor in its next 16 bytes.
+	 */
+	for (i = 32; i + 32 <= len; i += 32) {
+		va0 = __builtin_crypto_vpmsumd ((__vector unsigned long long)vdata0,
+				(__vector unsigned long long)vfold256);
+		va1 = __builtin_crypto_vpmsumd ((__vector unsigned long long)vdata1,
+				(__vector unsigned long long)vfold256);
+		va2 = __builtin_crypto_vpmsumd ((__vector unsigned long long)vdata2,
+				(__vector unsigned long long)vfold256);
+		va3 = __builtin_crypto_vpmsumd ((__vector unsigned long long)vdata3,
+				(__vector unsigned long long)vfold256);
+		va4 = __builtin_crypto_vpmsumd ((__vector unsigned long long)vdata4,
+				(__vector unsigned long long)vfold256);
+		va5 = __builtin_crypto_vpmsumd ((__vector unsigned long long)vdata5,
+				(__vector unsigned long long)vfold256);
+		va6 = __builtin_crypto_vpmsumd ((__vector unsigned long long)vdata6,
+				(__vector unsigned long long)vfold256);
+		va7 = __builtin_crypto_vpmsumd ((__vector unsigned long long)vdata7,
+				(__vector unsigned long long)vfold256);
+
+		VEC_LOAD(vdata0, i, p0);
+		VEC_LOAD(vdata1, i + 16, p0);
+		VEC_LOAD(vdata2, i, p1);
+		VEC_LOAD(vdata3, i + 16, p1);
+		VEC_LOAD(vdata4, i, p2);
+		VEC_LOAD(vdata5, i + 16, p2);
+		VEC_LOAD(vdata6, i, p3);
+		VEC_LOAD(vdata7, i + 16, p3);
+
+		vdata0 = vec_xor(vdata0, va0);
+		vdata1 = vec_xor(vdata1, va1);
+		vdata2 = vec_xor(vdata2, va2);
+		vdata3 = vec_xor(vdata3, va3);
+		vdata4 = vec_xor(vdata4, va4);
+		vdata5 = vec_xor(vdata5, va5);
+		vdata6 = vec_xor(vdata6, va6);
+		vdata7 = vec_xor(vdata7, va7);
+	}
+
+	/* Fold the even stream of each buffer into the odd one. */
+	va0 = __builtin_crypto_vpmsumd ((__vector unsigned long long)vdata0,
+			(__vector unsigned long long)vfold128);
+	va2 = __builtin_crypto_vpmsumd ((__vector unsigned long long)vdata2,
+			(__vector unsigned long long)vfold128);
+	va4 = __builtin_crypto_vpmsumd ((__vector unsigned long long)vdata4,
+			(__vector unsigned long long)vfold128);
+	va6 = __builtin_crypto_vpmsumd ((__vector unsigned long long)vdata6,
+			(__vector unsigned long long)vfold128);
+
+	vdata1 = vec_xor(vdata1, va0);
+	vdata3 = vec_xor(vdata3, va2);
+	vdata5 = vec_xor(vdata5, va4);
+	vdata7 = vec_xor(vdata7, va6);
+
+	/* An odd number of chunks leaves one more 16 bytes to fold in. */
+	if (i < len) {
+		va1 = __builtin_crypto_vpmsumd ((__vector unsigned long long)vdata1,
+				(__vector unsigned long long)vfold128);
+		va3 = __builtin_crypto_vpmsumd ((__vector unsigned long long)vdata3,
+				(__vector unsigned long long)vfold128);
+		va5 = __builtin_crypto_vpmsumd ((__vector unsigned long long)vdata5,
+				(__vector unsigned long long)vfold128);
+		va7 = __builtin_crypto_vpmsumd ((__vector unsigned long long)vdata7,
+				(__vector unsigned long long)vfold128);
+
+		VEC_LOAD(vdata1, i, p0);
+		VEC_LOAD(vdata3, i, p1);
+		VEC_LOAD(vdata5, i, p2);
+		VEC_LOAD(vdata7, i, p3);
+
+		vdata1 = vec_xor(vdata1, va1);
+		vdata3 = vec_xor(vdata3, va3);
+		vdata5 = vec_xor(vdata5, va5);
+		vdata7 = vec_xor(vdata7, va7);
+	}
+
+	crc[0] = crc32_reduce(vdata1, vcrc_fold_const, v_Barrett_const,
+			      CRC32_REFLECTED);
+	crc[1] = crc32_reduce(vdata3, vcrc_fold_const, v_Barrett_const,
+			      CRC32_REFLECTED);
+	crc[2] = crc32_reduce(vdata5, vcrc_fold_const, v_Barrett_const,
+			      CRC32_REFLECTED);
+	crc[3] = crc32_reduce(vdata7, vcrc_fold_const, v_Barrett_const,
+			      CRC32_REFLECTED);
+}
@@ -0,0 +1,433 @@
+/*
+ * Calculate a checksum over data that arrives in pieces: a stream of
+ * small appends, or an iovec.
+ *
+ * Calling crc32_vpmsum() on each piece pays for the byte at a time head
+ * and tail of every piece, and for a full reduction to 32 bits each
+ * time. Instead we treat the pieces as one stream of 16 byte chunks and
+ * fold them into 8 accumulators (1024 bits) by a fixed distance, as in
+ * vec_crc32_fold.c. Chunk k of a run goes into accumulator k % 8, so the
+ * state carried from one piece to the next is the 8 accumulators and the
+ * chunk count. Pieces are loaded with vec_xl so they need no alignment.
+ *
+ * A piece that doesn't end on a chunk boundary ends the run. The
+ * accumulators are folded into a 64 bit sum of products, which is shifted
+ * past the last 1-15 bytes with vcrc_shift_const, and those bytes are
+ * permuted into a vector and added to it, all in registers. The next
+ * piece starts a new run with the sum as its initial value.
+ *
+ * The data can be copied to a destination buffer as it is loaded, so
+ * copy and checksum take a single pass over memory.
+ *
+ * Nothing is reduced to 32 bits until crc32_stream_final(). Whatever is
+ * left is then folded into the sum, which is Barrett reduced once.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of either:
+ *
+ *  a) the GNU General Public License as published by the Free Software
+ *     Foundation; either version 2 of the License, or (at your option)
+ *     any later version, or
+ *  b) the Apache License, Version 2.0
+ */
+
+#include <altivec.h>
+#include <string.h>
+#include <sys/uio.h>
+#include "crc32_stream.h"
+
+#define POWER8_FOLD_INTRINSICS
+#define POWER8_SHIFT_INTRINSICS
+
+#ifdef CRC32_CONSTANTS_HEADER
+#include CRC32_CONSTANTS_HEADER
+#else
+#include "crc32_constants.h"
+#endif
+
+#define VMX_ALIGN	16
+#define VMX_ALIGN_MASK	(VMX_ALIGN-1)
+
+#if defined (__clang__)
+#include "clang_workaround.h"
+#else
+#define __builtin_pack_vector(a, b)  __builtin_pack_vector_int128 ((a), (b))
+#define __builtin_unpack_vector_0(a) __builtin_unpack_vector_int128 ((vector __int128_t)(a), 0)
+#define __builtin_unpack_vector_1(a) __builtin_unpack_vector_int128 ((vector __int128_t)(a), 1)
+#endif
+
+#include "crc32_reduce.h"
+
+#if defined(__BIG_ENDIAN__) && defined (REFLECT)
+#define BYTESWAP_DATA
+#elif defined(__LITTLE_ENDIAN__) && !defined(REFLECT)
+#define BYTESWAP_DATA
+#endif
+
+#ifdef BYTESWAP_DATA
+#define VEC_PERM(vr, va, vb, vc) vr = vec_perm(va, vb,\
+			(__vector unsigned char) vc)
+#if defined(__LITTLE_ENDIAN__)
+/* Byte reverse permute constant LE. */
+static const __vector unsigned long long vperm_const
+	__attribute__ ((aligned(16))) = { 0x08090A0B0C0D0E0FUL,
+			0x0001020304050607UL };
+#else
+static const __vector unsigned long long vperm_const
+	__attribute__ ((aligned(16))) = { 0x0F0E0D0C0B0A0908UL,
+			0X0706050403020100UL };
+#endif
+#else
+#define VEC_PERM(vr, va, vb, vc)
+#endif
+
+/* Load 16 bytes, storing them to d on the way if it isn't NULL. */
+#define VEC_LOAD(vr, off, p, d) do {					\
+	vr = vec_xl((off), (unsigned long long *)(p));			\
+	if (d)								\
+		vec_xst(vr, (off), (unsigned long long *)(d));		\
+	VEC_PERM(vr, vr, vr, vperm_const);				\
+} while (0)
+
+/*
+ * Bytes 0-15 select the zero vector and bytes 16-31 are 0-15. 16 bytes
+ * loaded at offset n permute the first n bytes of a vector to its least
+ * significant end; at offset 16 they are the identity.
+ */
+static const unsigned char vpartial_const[32]
+	__attribute__ ((aligned(16))) = {
+	16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16, 16,
+	 0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 };
+
+#ifndef CRC32_STREAM_INIT_FUNCTION
+#define CRC32_STREAM_INIT_FUNCTION	crc32_stream_init
+#endif
+#ifndef CRC32_STREAM_UPDATE_FUNCTION
+#define CRC32_STREAM_UPDATE_FUNCTION	crc32_stream_update
+#endif
+#ifndef CRC32_STREAM_FINAL_FUNCTION
+#define CRC32_STREAM_FINAL_FUNCTION	crc32_stream_final
+#endif
+#ifndef CRC32_STREAM_COPY_FUNCTION
+#define CRC32_STREAM_COPY_FUNCTION	crc32_stream_copy
+#endif
+#ifndef CRC32_IOV_FUNCTION
+#define CRC32_IOV_FUNCTION		crc32_vpmsum_iov
+#endif
+#ifndef CRC32_COPY_FUNCTION
+#define CRC32_COPY_FUNCTION		crc32_vpmsum_copy
+#endif
+
+/* The vector state, kept in the context as arrays of 64 bit values */
+#define ACC(s, i)	(((__vector unsigned long long *)(s)->acc)[i])
+#define SUM(s)		(*(__vector unsigned long long *)(s)->sum)
+
+/* Start a checksum with initial value crc. */
+void CRC32_STREAM_INIT_FUNCTION(struct crc32_stream *s, unsigned int crc)
+{
+	const __vector unsigned long long vzero = {0,0};
+	int i;
+
+#ifdef CRC_XOR
+	crc ^= 0xffffffff;
+#endif
+
+	for (i = 0; i < 8; i++)
+		ACC(s, i) = vzero;
+
+	SUM(s) = crc32_init_sum(crc, CRC32_REFLECTED);
+	s->chunks = 0;
+}
+
+/* Fold one 16 byte chunk into the accumulator it belongs to. */
+static inline void crc32_fold_chunk(struct crc32_stream *s,
+				    __vector unsigned long long vdata)
+{
+	const __vector unsigned long long vfold1024 = vec_ld(0, vcrc_fold_const);
+	unsigned int i = s->chunks % 8;
+
+	/* The first chunk of a run carries the sum before it. */
+	if (!s->chunks)
+		vdata = vec_xor(vdata, crc32_sum_vcrc(SUM(s), vcrc_shift_const,
+						      CRC32_REFLECTED));
+
+	ACC(s, i) = vec_xor(vdata, __builtin_crypto_vpmsumd (
+		(__vector unsigned long long)ACC(s, i),
+		(__vector unsigned long long)vfold1024));
+	s->chunks++;
+}
+
+/*
+ * Fold len bytes starting at a multiple of 8 chunks. len is a multiple
+ * of 128. The accumulators are kept in registers for the whole run.
+ * If dst isn't NULL the data is copied there as it is loaded.
+ */
+static inline __attribute__ ((always_inline)) void
+crc32_fold_blocks(struct crc32_stream *s, unsigned char *dst,
+		  const unsigned char *p, unsigned long len)
+{
+	const __vector unsigned long long vfold1024 = vec_ld(0, vcrc_fold_const);
+
+	__vector unsigned long long vdata0, vdata1, vdata2, vdata3, vdata4,
+		vdata5, vdata6, vdata7;
+
+	__vector unsigned long long va0, va1, va2, va3, va4, va5, va6, va7;
+
+	__vector unsigned long long v0 = ACC(s, 0);
+	__vector unsigned long long v1 = ACC(s, 1);
+	__vector unsigned long long v2 = ACC(s, 2);
+	__vector unsigned long long v3 = ACC(s, 3);
+	__vector unsigned long long v4 = ACC(s, 4);
+	__vector unsigned long long v5 = ACC(s, 5);
+	__vector unsigned long long v6 = ACC(s, 6);
+	__vector unsigned long long v7 = ACC(s, 7);
+
+	/* Nothing to fold into yet, xor the sum into chunk 0. */
+	if (!s->chunks) {
+		VEC_LOAD(vdata0, 0, p, dst);
+		VEC_LOAD(vdata1, 16, p, dst);
+		VEC_LOAD(vdata2, 32, p, dst);
+		VEC_LOAD(vdata3, 48, p, dst);
+		VEC_LOAD(vdata4, 64, p, dst);
+		VEC_LOAD(vdata5, 80, p, dst);
+		VEC_LOAD(vdata6, 96, p, dst);
+		VEC_LOAD(vdata7, 112, p, dst);
+
+		v0 = vec_xor(vdata0, crc32_sum_vcrc(SUM(s), vcrc_shift_const,
+						    CRC32_REFLECTED));
+		v1 = vdata1;
+		v2 = vdata2;
+		v3 = vdata3;
+		v4 = vdata4;
+		v5 = vdata5;
+		v6 = vdata6;
+		v7 = vdata7;
+
+		s->chunks += 8;
+		if (dst)
+			dst += 128;
+		p += 128;
+		len -= 128;
+	}
+
+	s->chunks += len / 16;
+
+	while (len) {
+		va0 = __builtin_crypto_vpmsumd ((__vector unsigned long long)v0,
+				(__vector unsigned long long)vfold1024);
+		va1 = __builtin_crypto_vpmsumd ((__vector unsigned long long)v1,
+				(__vector unsigned long long)vfold1024);
+		va2 = __builtin_crypto_vpmsumd ((__vector unsigned long long)v2,
+				(__vector unsigned long long)vfold1024);
+		va3 = __builtin_crypto_vpmsumd ((__vector unsigned long long)v3,
+				(__vector unsigned long long)vfold1024);
+		va4 = __builtin_crypto_vpmsumd ((__vector unsigned long long)v4,
+				(__vector unsigned long long)vfold1024);
+		va5 = __builtin_crypto_vpmsumd ((__vector unsigned long long)v5,
+				(__vector unsigned long long)vfold1024);
+		va6 = __builtin_crypto_vpmsumd ((__vector unsigned long long)v6,
+				(__vector unsigned long long)vfold1024);
+		va7 = __builtin_crypto_vpmsumd ((__vector unsigned long long)v7,
+				(__vector unsigned long long)vfold1024);
+
+		VEC_LOAD(vdata0, 0, p, dst);
+		VEC_LOAD(vdata1, 16, p, dst);
+		VEC_LOAD(vdata2, 32, p, dst);
+		VEC_LOAD(vdata3, 48, p, dst);
+		VEC_LOAD(vdata4, 64, p, dst);
+		VEC_LOAD(vdata5, 80, p, dst);
+		VEC_LOAD(vdata6, 96, p, dst);
+		VEC_LOAD(vdata7, 112, p, dst);
+
+		if (dst)
+			dst += 128;
+		p += 128;
+		len -= 128;
+
+		v0 = vec_xor(vdata0, va0);
+		v1 = vec_xor(vdata1, va1);
+		v2 = vec_xor(vdata2, va2);
+		v3 = vec_xor(vdata3, va3);
+		v4 = vec_xor(vdata4, va4);
+		v5 = vec_xor(vdata5, va5);
+		v6 = vec_xor(vdata6, va6);
+		v7 = vec_xor(vdata7, va7);
+	}
+
+	ACC(s, 0) = v0;
+	ACC(s, 1) = v1;
+	ACC(s, 2) = v2;
+	ACC(s, 3) = v3;
+	ACC(s, 4) = v4;
+	ACC(s, 5) = v5;
+	ACC(s, 6) = v6;
+	ACC(s, 7) = v7;
+}
+
+/*
+ * End the run: fold the accumulators together in stream order into the sum
+ * of products.
+ */
+static void crc32_fold_sum(struct crc32_stream *s)
+{
+	const __vector unsigned long long vzero = {0,0};
+	__vector unsigned long long v[8];
+	unsigned int i, j;
+
+	if (!s->chunks)
+		return;
+
+	/*
+	 * Accumulator i holds the chunks up to and including its last one.
+	 * Put them in stream order, oldest first; accumulators never used
+	 * (fewer than 8 chunks) are zero and sit in front, where they don't
+	 * change the result.
+	 */
+	i = s->chunks % 8;
+	for (j = 0; j < 8; j++)
+		v[j] = ACC(s, (i + j) % 8);
+
+	SUM(s) = crc32_sum(crc32_fold_streams(v, vcrc_fold_const),
+			   vcrc_fold_const);
+
+	for (j = 0; j < 8; j++)
+		ACC(s, j) = vzero;
+	s->chunks = 0;
+}
+
+/*
+ * Add the last 1-15 bytes of a segment to the sum. They are loaded from
+ * the one or two aligned quadwords that hold them, so we never touch
+ * another page, and permuted to the end of a zeroed vector. That is a 16
+ * byte chunk we reduce like the last one of a buffer, and the sum is
+ * shifted past it.
+ */
+static void crc32_fold_partial(struct crc32_stream *s,
+			       const unsigned char *p, unsigned long len)
+{
+	const __vector unsigned char vzero = {0};
+	__vector unsigned char vperm;
+	__vector unsigned long long vdata;
+
+	crc32_fold_sum(s);
+
+	/* The 16 bytes at p, then the first len of them at the end */
+	vperm = vec_add(vec_ld(16, vpartial_const),
+		vec_splats((unsigned char)((unsigned long)p & VMX_ALIGN_MASK)));
+	vdata = (__vector unsigned long long)vec_perm(vec_ld(0, p),
+		vec_ld(len - 1, p), vperm);
+
+	vdata = (__vector unsigned long long)vec_perm(
+		(__vector unsigned char)vdata, vzero,
+		vec_xl(len, vpartial_const));
+	VEC_PERM(vdata, vdata, vdata, vperm_const);
+
+	SUM(s) = vec_xor(crc32_shift(SUM(s), len, vcrc_shift_const,
+				     CRC32_REFLECTED),
+			 crc32_sum(vdata, vcrc_fold_const));
+}
+
+/*
+ * Append len bytes at p, copying them to dst if it isn't NULL. This is
+ * inlined into the two callers so the copy costs nothing when unused.
+ */
+static inline __attribute__ ((always_inline)) void
+crc32_stream_append(struct crc32_stream *s, unsigned char *dst,
+		    const unsigned char *p, unsigned long len)
+{
+	__vector unsigned long long vdata;
+	unsigned long n;
+
+	/* Get back to the first accumulator. */
+	while ((s->chunks % 8) && len >= VMX_ALIGN) {
+		VEC_LOAD(vdata, 0, p, dst);
+		crc32_fold_chunk(s, vdata);
+		if (dst)
+			dst += VMX_ALIGN;
+		p += VMX_ALIGN;
+		len -= VMX_ALIGN;
+	}
+
+	if (len >= 128) {
+		n = len & ~127UL;
+		crc32_fold_blocks(s, dst, p, n);
+		if (dst)
+			dst += n;
+		p += n;
+		len -= n;
+	}
+
+	while (len >= VMX_ALIGN) {
+		VEC_LOAD(vdata, 0, p, dst);
+		crc32_fold_chunk(s, vdata);
+		if (dst)
+			dst += VMX_ALIGN;
+		p += VMX_ALIGN;
+		len -= VMX_ALIGN;
+	}
+
+	if (len) {
+		if (dst)
+			memcpy(dst, p, len);
+		crc32_fold_partial(s, p, len);
+	}
+}
+
+/* Append len bytes at p. */
+void CRC32_STREAM_UPDATE_FUNCTION(struct crc32_stream *s,
+				  const unsigned char *p, unsigned long len)
+{
+	crc32_stream_append(s, NULL, p, len);
+}
+
+/* Append len bytes at src, and copy them to dst. */
+void CRC32_STREAM_COPY_FUNCTION(struct crc32_stream *s, unsigned char *dst,
+				const unsigned char *src, unsigned long len)
+{
+	crc32_stream_append(s, dst, src, len);
+}
+
+/* Return the checksum of everything appended since init. */
+unsigned int CRC32_STREAM_FINAL_FUNCTION(struct crc32_stream *s)
+{
+	unsigned int crc;
+
+	crc32_fold_sum(s);
+	crc = crc32_sum_barrett(SUM(s), v_Barrett_const, CRC32_REFLECTED);
+
+#ifdef CRC_XOR
+	crc ^= 0xffffffff;
+#endif
+
+	return crc;
+}
+
+unsigned int CRC32_IOV_FUNCTION(unsigned int crc, const struct iovec *iov,
+				int iovcnt)
+{
+	struct crc32_stream s;
+	int i;
+
+	CRC32_STREAM_INIT_FUNCTION(&s, crc);
+
+	for (i = 0; i < iovcnt; i++)
+		CRC32_STREAM_UPDATE_FUNCTION(&s, iov[i].iov_base,
+					     iov[i].iov_len);
+
+	return CRC32_STREAM_FINAL_FUNCTION(&s);
+}
+
+/*
+ * Copy len bytes from src to dst and return their checksum, reading the
+ * data once.
+ */
+unsigned int CRC32_COPY_FUNCTION(unsigned int crc, unsigned char *dst,
+				 const unsigned char *src, unsigned long len)
+{
+	struct crc32_stream s;
+
+	CRC32_STREAM_INIT_FUNCTION(&s, crc);
+	CRC32_STREAM_COPY_FUNCTION(&s, dst, src, len);
+
+	return CRC32_STREAM_FINAL_FUNCTION(&s);
+}
@@ -0,0 +1,337 @@
+/*
+ * Calculate a 64 bit CRC, eg CRC-64/XZ, CRC-64/NVME or CRC-64/ECMA-182,
+ * using POWER8 vpmsum instructions.
+ *
+ * This follows vec_crc32_fold.c: the data is checksummed in 8 parallel
+ * 16 byte streams which are folded forward by 1024 bits on every
+ * iteration, then folded together (by 512, 256 and 128 bits) and any
+ * remaining 16 byte chunks folded in one at a time. A 64 bit remainder
+ * fills a doubleword, so every fold is a single vpmsumd whose 127 bit
+ * products still fit in 128 bits.
+ *
+ * The final 128 bits are folded by 64 bits, to add the 64 bits of 0s a
+ * CRC appends, and Barrett reduced with x = 64:
+ *
+ *	q = floor(a / 2^64) * floor(2^128 / n) / 2^64
+ *	a mod n = a - q * n
+ *
+ * Both 2^128 / n and n have 65 bits, so the top bit of each is applied
+ * with an xor rather than a multiply. In the reflected case the product
+ * of two 64 bit values is 127 bits, one bit short of lining up with the
+ * data, so each product is shifted left one bit.
+ *
+ * The constants come from crc64_constants.c, by default in
+ * crc64_constants.h. Use CRC64_CONSTANTS_HEADER and CRC64_FUNCTION to
+ * build a second polynomial alongside.
+ *
+ * http://en.wikipedia.org/wiki/Barrett_reduction
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of either:
+ *
+ *  a) the GNU General Public License as published by the Free Software
+ *     Foundation; either version 2 of the License, or (at your option)
+ *     any later version, or
+ *  b) the Apache License, Version 2.0
+ */
+
+#include <altivec.h>
+
+#define POWER8_INTRINSICS
+#define CRC64_SLICE_TABLE
+
+#ifdef CRC64_CONSTANTS_HEADER
+#include CRC64_CONSTANTS_HEADER
+#else
+#include "crc64_constants.h"
+#endif
+
+#define VMX_ALIGN	16
+#define VMX_ALIGN_MASK	(VMX_ALIGN-1)
+
+/* Number of 16 byte streams */
+#define CRC64_STREAMS	8
+
+#if defined (__clang__)
+#include "clang_workaround.h"
+#else
+#define __builtin_pack_vector(a, b)  __builtin_pack_vector_int128 ((a), (b))
+#define __builtin_unpack_vector_0(a) __builtin_unpack_vector_int128 ((vector __int128_t)(a), 0)
+#define __builtin_unpack_vector_1(a) __builtin_unpack_vector_int128 ((vector __int128_t)(a), 1)
+#endif
+
+#define CRC64_PRAGMA(x)	_Pragma(#x)
+#define CRC64_UNROLL(n)	CRC64_PRAGMA(GCC unroll n)
+
+#if defined(__BIG_ENDIAN__) && defined (CRC64_REFLECT)
+#define BYTESWAP_DATA
+#elif defined(__LITTLE_ENDIAN__) && !defined(CRC64_REFLECT)
+#define BYTESWAP_DATA
+#endif
+
+#ifdef BYTESWAP_DATA
+#define VEC_PERM(vr, va, vb, vc) vr = vec_perm(va, vb,\
+			(__vector unsigned char) vc)
+#if defined(__LITTLE_ENDIAN__)
+/* Byte reverse permute constant LE. */
+static const __vector unsigned long long vperm_const
+	__attribute__ ((aligned(16))) = { 0x08090A0B0C0D0E0FUL,
+			0x0001020304050607UL };
+#else
+static const __vector unsigned long long vperm_const
+	__attribute__ ((aligned(16))) = { 0x0F0E0D0C0B0A0908UL,
+			0X0706050403020100UL };
+#endif
+#else
+#define VEC_PERM(vr, va, vb, vc)
+#endif
+
+static unsigned long __attribute__ ((aligned (32)))
+__crc64_vpmsum(unsigned long crc, const void *p, unsigned long len);
+
+/*
+ * Slice by 8 for the head, tail and short buffers: the 8 bytes at p are
+ * looked up in separate tables at once and the results xored together.
+ * The doubleword is assembled a byte at a time, which the compiler turns
+ * into a single (possibly byte reversed) load.
+ */
+static inline unsigned long crc64_bytes(unsigned long crc,
+					const unsigned char *p,
+					unsigned long len)
+{
+	unsigned long q;
+	int k;
+
+	while (len >= 8) {
+		q = 0;
+		CRC64_UNROLL(8)
+		for (k = 0; k < 8; k++)
+#ifdef CRC64_REFLECT
+			q |= (unsigned long)p[k] << (8 * k);
+#else
+			q |= (unsigned long)p[k] << (56 - 8 * k);
+#endif
+		q ^= crc;
+
+		crc = 0;
+		CRC64_UNROLL(8)
+		for (k = 0; k < 8; k++)
+#ifdef CRC64_REFLECT
+			crc ^= crc64_slice_table[7 - k][(q >> (8 * k)) & 0xff];
+#else
+			crc ^= crc64_slice_table[7 - k][(q >> (56 - 8 * k)) & 0xff];
+#endif
+
+		p += 8;
+		len -= 8;
+	}
+
+	while (len--) {
+#ifdef CRC64_REFLECT
+		crc = crc64_slice_table[0][(crc ^ *p++) & 0xff] ^ (crc >> 8);
+#else
+		crc = crc64_slice_table[0][((crc >> 56) ^ *p++) & 0xff] ^
+			(crc << 8);
+#endif
+	}
+
+	return crc;
+}
+
+#ifndef CRC64_FUNCTION
+#define CRC64_FUNCTION	crc64_vpmsum
+#endif
+
+unsigned long CRC64_FUNCTION(unsigned long crc, const unsigned char *p,
+			     unsigned long len)
+{
+	unsigned int prealign;
+	unsigned int tail;
+
+#ifdef CRC64_XOR
+	crc ^= 0xffffffffffffffffUL;
+#endif
+
+	if (len < VMX_ALIGN + VMX_ALIGN_MASK) {
+		crc = crc64_bytes(crc, p, len);
+		goto out;
+	}
+
+	if ((unsigned long)p & VMX_ALIGN_MASK) {
+		prealign = VMX_ALIGN - ((unsigned long)p & VMX_ALIGN_MASK);
+		crc = crc64_bytes(crc, p, prealign);
+		len -= prealign;
+		p += prealign;
+	}
+
+	crc = __crc64_vpmsum(crc, p, len & ~VMX_ALIGN_MASK);
+
+	tail = len & VMX_ALIGN_MASK;
+	if (tail) {
+		p += len & ~VMX_ALIGN_MASK;
+		crc = crc64_bytes(crc, p, tail);
+	}
+
+out:
+#ifdef CRC64_XOR
+	crc ^= 0xffffffffffffffffUL;
+#endif
+
+	return crc;
+}
+
+/*
+ * Checksum len bytes at p, 16 byte aligned and a multiple of 16 bytes.
+ */
+static unsigned long __attribute__ ((aligned (32)))
+__crc64_vpmsum(unsigned long crc, const void *p, unsigned long len) {
+
+	const __vector unsigned long long vzero = {0,0};
+
+#ifdef CRC64_REFLECT
+	const __vector unsigned long long vones = {0xffffffffffffffffUL,
+		0xffffffffffffffffUL};
+
+	const __vector unsigned long long vmask_64bit =
+		(__vector unsigned long long)vec_sld((__vector unsigned char)vzero,
+			(__vector unsigned char)vones, 8);
+
+	const __vector unsigned char vsht_splat = vec_splat_u8 (1);
+#endif
+
+	/* Fold by 1024, 512, 256, 128 and 64 bits. */
+	const __vector unsigned long long vfold1024 = vec_ld(0, vcrc64_fold_const);
+	const __vector unsigned long long vfold512 = vec_ld(16, vcrc64_fold_const);
+	const __vector unsigned long long vfold256 = vec_ld(32, vcrc64_fold_const);
+	const __vector unsigned long long vfold128 = vec_ld(48, vcrc64_fold_const);
+	const __vector unsigned long long vfold64 = vec_ld(64, vcrc64_fold_const);
+
+	__vector unsigned long long vcrc, vconst1, vconst2;
+
+	/* v[0]-v[7] will contain our checksums */
+	__vector unsigned long long v[CRC64_STREAMS];
+
+	__vector unsigned long long vdata0, v0, v1;
+
+	int j;
+
+	if (len == 0)
+		return crc;
+
+#ifdef CRC64_REFLECT
+	vcrc = (__vector unsigned long long)__builtin_pack_vector(0UL, crc);
+#else
+	vcrc = (__vector unsigned long long)__builtin_pack_vector(crc, 0UL);
+#endif
+
+	if (len >= 128) {
+		CRC64_UNROLL(8)
+		for (j = 0; j < CRC64_STREAMS; j++) {
+			v[j] = vec_ld(j * 16, (__vector unsigned long long *)p);
+			VEC_PERM(v[j], v[j], v[j], vperm_const);
+		}
+
+		/* xor in initial value */
+		v[0] = vec_xor(v[0], vcrc);
+
+		p = (char *)p + 128;
+		len -= 128;
+
+		/*
+		 * main loop. Every 128 bytes we fold each chunk forward by 1024
+		 * bits and xor in the next 16 bytes of its stream.
+		 */
+		while (len >= 128) {
+			CRC64_UNROLL(8)
+			for (j = 0; j < CRC64_STREAMS; j++) {
+				vdata0 = vec_ld(j * 16, (__vector unsigned long long *)p);
+				VEC_PERM(vdata0, vdata0, vdata0, vperm_const);
+
+				v[j] = vec_xor(vdata0,
+					__builtin_crypto_vpmsumd(v[j], vfold1024));
+			}
+
+			p = (char *)p + 128;
+			len -= 128;
+		}
+
+		/* Fold the 8 chunks into one: by 512, then 256, then 128 bits. */
+		CRC64_UNROLL(4)
+		for (j = 0; j < 4; j++)
+			v[j] = vec_xor(v[j + 4],
+				__builtin_crypto_vpmsumd(v[j], vfold512));
+
+		CRC64_UNROLL(2)
+		for (j = 0; j < 2; j++)
+			v[j] = vec_xor(v[j + 2],
+				__builtin_crypto_vpmsumd(v[j], vfold256));
+
+		vdata0 = vec_xor(v[1], __builtin_crypto_vpmsumd(v[0], vfold128));
+	} else {
+		vdata0 = vec_ld(0, (__vector unsigned long long *)p);
+		VEC_PERM(vdata0, vdata0, vdata0, vperm_const);
+
+		/* xor in initial value */
+		vdata0 = vec_xor(vdata0, vcrc);
+
+		p = (char *)p + 16;
+		len -= 16;
+	}
+
+	/* Now fold in the tail (0-112 bytes), 16 bytes at a time. */
+	while (len) {
+		v0 = vec_ld(0, (__vector unsigned long long *)p);
+		VEC_PERM(v0, v0, v0, vperm_const);
+
+		vdata0 = vec_xor(v0, __builtin_crypto_vpmsumd(vdata0, vfold128));
+
+		p = (char *)p + 16;
+		len -= 16;
+	}
+
+	/* Append the 64 bits of zeros, leaving a 128 bit a to reduce. */
+	vdata0 = __builtin_crypto_vpmsumd(vdata0, vfold64);
+
+	/* Barrett Reduction */
+	vconst1 = vec_ld(0, vcrc64_barrett_const);
+	vconst2 = vec_ld(16, vcrc64_barrett_const);
+
+#ifndef CRC64_REFLECT
+	/* floor(a / 2^64) */
+	v1 = (__vector unsigned long long)vec_sld ((__vector unsigned char)vzero,
+			(__vector unsigned char)vdata0, 8);
+	/* ma, with the top bit of m applied by xoring in floor(a / 2^64) */
+	v1 = __builtin_crypto_vpmsumd (v1, vconst1);
+	v1 = vec_xor (v1, vdata0);
+	/* q = floor(ma / 2^64) */
+	v1 = (__vector unsigned long long)vec_sld ((__vector unsigned char)vzero,
+			(__vector unsigned char)v1, 8);
+	/* low 64 bits of qn, the top bit of n only affects the high bits */
+	v1 = __builtin_crypto_vpmsumd (v1, vconst2);
+	/* a - qn, subtraction is xor in GF(2) */
+	v0 = vec_xor (vdata0, v1);
+
+	return __builtin_unpack_vector_1 (v0);
+#else
+	/*
+	 * Bit reflected, so the high 64 bits of a are in the low doubleword
+	 * and the result ends up in the high doubleword.
+	 */
+	v1 = vec_and (vdata0, vmask_64bit);
+	/* ma, shifted to line up with a */
+	v1 = __builtin_crypto_vpmsumd (v1, vconst1);
+	v1 = (__vector unsigned long long)vec_sll ((__vector unsigned char)v1,
+			vsht_splat);
+	v1 = vec_xor (v1, vdata0);
+	/* q */
+	v1 = vec_and (v1, vmask_64bit);
+	/* qn, shifted to line up with a */
+	v1 = __builtin_crypto_vpmsumd (v1, vconst2);
+	v1 = (__vector unsigned long long)vec_sll ((__vector unsigned char)v1,
+			vsht_splat);
+	/* a - qn, subtraction is xor in GF(2) */
+	v0 = vec_xor (vdata0, v1);
+
+	return __builtin_unpack_vector_0 (v0);
+#endif
+}